@@ -0,0 +1,385 @@
+//measures the algorithms of Algorithm.h against their std counterparts on the same inputs
+//and checks that both produce the same result;
+//build with CMake from the repository root and run dvtl_bench_algorithm --help for the options
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "Algorithm.h"
+#include "Bench.h"
+
+namespace
+{
+	struct Record64
+	{
+		long long key;
+		long long payload[7];
+	};
+
+	inline bool operator==(const Record64& left, const Record64& right) { return left.key == right.key && std::equal(left.payload, left.payload + 7, right.payload); }
+	inline bool operator!=(const Record64& left, const Record64& right) { return !(left == right); }
+	inline bool operator< (const Record64& left, const Record64& right) { return left.key < right.key; }
+	inline bool operator> (const Record64& left, const Record64& right) { return left.key > right.key; }
+	inline bool operator<=(const Record64& left, const Record64& right) { return left.key <= right.key; }
+	inline bool operator>=(const Record64& left, const Record64& right) { return left.key >= right.key; }
+
+	template<typename T> T Make_value(long long key);
+	template<> int Make_value<int>(long long key) { return static_cast<int>(key); }
+	template<> double Make_value<double>(long long key) { return static_cast<double>(key) * 0.5; }
+	template<> Record64 Make_value<Record64>(long long key)
+	{
+		Record64 record{ key, {} };
+		for (long long i = 0; i < 7; ++i)
+			record.payload[i] = key ^ i;
+		return record;
+	}
+
+	inline long long Key_of(int value) { return value; }
+	inline long long Key_of(double value) { return static_cast<long long>(value * 2); }
+	inline long long Key_of(const Record64& value) { return value.key; }
+
+	template<typename T> const char* Type_name();
+	template<> const char* Type_name<int>() { return "int"; }
+	template<> const char* Type_name<double>() { return "double"; }
+	template<> const char* Type_name<Record64>() { return "record64"; }
+
+	enum class Distribution { sorted, reversed, random, few_unique, organ_pipe };
+
+	const Distribution distributions[] = { Distribution::sorted, Distribution::reversed, Distribution::random, Distribution::few_unique, Distribution::organ_pipe };
+
+	const char* Distribution_name(Distribution distribution)
+	{
+		switch (distribution)
+		{
+		case Distribution::sorted:		return "sorted";
+		case Distribution::reversed:	return "reversed";
+		case Distribution::random:		return "random";
+		case Distribution::few_unique:	return "few_unique";
+		case Distribution::organ_pipe:	return "organ_pipe";
+		}
+		return "";
+	}
+
+	std::vector<long long> Make_keys(Distribution distribution, size_t size)
+	{
+		std::vector<long long> keys(size);
+		std::mt19937_64 generator(size * 31 + static_cast<size_t>(distribution));
+		long long count = static_cast<long long>(size);
+
+		for (long long i = 0; i < count; ++i)
+		{
+			switch (distribution)
+			{
+			case Distribution::sorted:		keys[i] = i; break;
+			case Distribution::reversed:	keys[i] = count - i; break;
+			case Distribution::random:		keys[i] = static_cast<long long>(generator() % (1ull << 40)); break;
+			case Distribution::few_unique:	keys[i] = static_cast<long long>(generator() % 16); break;
+			case Distribution::organ_pipe:	keys[i] = i < count / 2 ? i : count - i; break;
+			}
+		}
+
+		return keys;
+	}
+
+	//every function works on one block: data and an equally sized scratch output, returns a value to compare
+	template<typename T>
+	using Run = size_t(*)(T* data, T* scratch, size_t size);
+
+	//receives the DVTL block and result and the std ones, nullptr compares data, scratch and result exactly
+	template<typename T>
+	using Check = bool(*)(const T* data, const T* scratch, size_t result, const T* expectedData, const T* expectedScratch, size_t expectedResult, size_t size);
+
+	template<typename T>
+	struct Case
+	{
+		const char* name;
+		size_t maxSize;				//caps algorithms with quadratic behaviour
+		bool usesScratch;
+		void(*prepare)(std::vector<T>& input);
+		Run<T> dvtl;
+		Run<T> reference;
+		Check<T> check;
+	};
+
+	template<typename T> bool Is_multiple_of_3(const T& value) { return Key_of(value) % 3 == 0; }
+	template<typename T> T Twice(const T& value) { return Make_value<T>(Key_of(value) * 2); }
+
+	template<typename T> void Sort_input(std::vector<T>& input) { std::sort(input.begin(), input.end()); }
+
+	template<typename T> void Sort_halves(std::vector<T>& input)
+	{
+		std::sort(input.begin(), input.begin() + input.size() / 2);
+		std::sort(input.begin() + input.size() / 2, input.end());
+	}
+
+	//queries hit and miss the sorted data
+	template<typename T> T Query(const T* data, size_t size, size_t i)
+	{
+		long long key = Key_of(data[(i * 7919) % size]);
+		return Make_value<T>(i % 2 == 0 ? key : key + 1);
+	}
+
+	template<typename T>
+	bool Same_result(const T*, const T*, size_t result, const T*, const T*, size_t expectedResult, size_t)
+	{
+		return result == expectedResult;
+	}
+
+	template<typename T>
+	bool Same_prefix(const T* data, const T*, size_t result, const T* expectedData, const T*, size_t expectedResult, size_t size)
+	{
+		size_t count = std::min(result, size);
+		return result == expectedResult && std::equal(data, data + count, expectedData);
+	}
+
+	template<typename T>
+	bool Same_nth(const T* data, const T*, size_t, const T* expectedData, const T*, size_t, size_t size)
+	{
+		return !(data[size / 2] < expectedData[size / 2]) && !(expectedData[size / 2] < data[size / 2]);
+	}
+
+	template<typename T>
+	bool Same_partial(const T* data, const T*, size_t, const T* expectedData, const T*, size_t, size_t size)
+	{
+		return std::equal(data, data + size / 10, expectedData);
+	}
+
+	template<typename T>
+	bool Is_heap_result(const T* data, const T*, size_t, const T*, const T*, size_t, size_t size)
+	{
+		return std::is_heap(data, data + size);
+	}
+
+	template<typename T>
+	bool Is_partition_result(const T* data, const T*, size_t result, const T*, const T*, size_t expectedResult, size_t size)
+	{
+		return result == expectedResult && std::is_partitioned(data, data + size, Is_multiple_of_3<T>) && std::partition_point(data, data + size, Is_multiple_of_3<T>) == data + result;
+	}
+
+	template<typename T>
+	std::vector<Case<T>> Make_cases()
+	{
+		std::vector<Case<T>> cases = {
+			{ "Sort", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Sort(data, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::sort(data, data + size); return 0; }, nullptr },
+			{ "Stable_sort", 100000, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Stable_sort(data, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::stable_sort(data, data + size); return 0; }, nullptr },
+			{ "Partial_sort", 10000, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Partial_sort(data, data + size / 10, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::partial_sort(data, data + size / 10, data + size); return 0; }, Same_partial<T> },
+			{ "Nth_element", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Nth_element(data, data + size / 2, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::nth_element(data, data + size / 2, data + size); return 0; }, Same_nth<T> },
+			{ "Make_heap", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Make_heap(data, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::make_heap(data, data + size); return 0; }, Is_heap_result<T> },
+			{ "Inplace_merge", 100000, false, Sort_halves<T>,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Inplace_merge(data, data + size / 2, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::inplace_merge(data, data + size / 2, data + size); return 0; }, nullptr },
+			{ "Merge", 0, true, Sort_halves<T>,
+				[](T* data, T* scratch, size_t size) -> size_t { return DVTL::Merge(data, data + size / 2, data + size / 2, data + size, scratch) - scratch; },
+				[](T* data, T* scratch, size_t size) -> size_t { return std::merge(data, data + size / 2, data + size / 2, data + size, scratch) - scratch; }, nullptr },
+			{ "Lower_bound", 0, false, Sort_input<T>,
+				[](T* data, T*, size_t size) -> size_t { size_t sum = 0; for (size_t i = 0; i < size; ++i) sum += DVTL::Lower_bound(data, data + size, Query(data, size, i)) - data; return sum; },
+				[](T* data, T*, size_t size) -> size_t { size_t sum = 0; for (size_t i = 0; i < size; ++i) sum += std::lower_bound(data, data + size, Query(data, size, i)) - data; return sum; }, Same_result<T> },
+			{ "Upper_bound", 0, false, Sort_input<T>,
+				[](T* data, T*, size_t size) -> size_t { size_t sum = 0; for (size_t i = 0; i < size; ++i) sum += DVTL::Upper_bound(data, data + size, Query(data, size, i)) - data; return sum; },
+				[](T* data, T*, size_t size) -> size_t { size_t sum = 0; for (size_t i = 0; i < size; ++i) sum += std::upper_bound(data, data + size, Query(data, size, i)) - data; return sum; }, Same_result<T> },
+			{ "Binary_search", 0, false, Sort_input<T>,
+				[](T* data, T*, size_t size) -> size_t { size_t sum = 0; for (size_t i = 0; i < size; ++i) sum += DVTL::Binary_search(data, data + size, Query(data, size, i)); return sum; },
+				[](T* data, T*, size_t size) -> size_t { size_t sum = 0; for (size_t i = 0; i < size; ++i) sum += std::binary_search(data, data + size, Query(data, size, i)); return sum; }, Same_result<T> },
+			{ "Find", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Find(data, data + size, Make_value<T>(-1)) - data; },
+				[](T* data, T*, size_t size) -> size_t { return std::find(data, data + size, Make_value<T>(-1)) - data; }, Same_result<T> },
+			{ "Count", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Count(data, data + size, data[size / 2]); },
+				[](T* data, T*, size_t size) -> size_t { return std::count(data, data + size, data[size / 2]); }, Same_result<T> },
+			{ "Min_element", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Min_element(data, data + size) - data; },
+				[](T* data, T*, size_t size) -> size_t { return std::min_element(data, data + size) - data; }, Same_result<T> },
+			{ "Max_element", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Max_element(data, data + size) - data; },
+				[](T* data, T*, size_t size) -> size_t { return std::max_element(data, data + size) - data; }, Same_result<T> },
+			{ "Is_sorted", 0, false, Sort_input<T>,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Is_sorted(data, data + size); },
+				[](T* data, T*, size_t size) -> size_t { return std::is_sorted(data, data + size); }, Same_result<T> },
+			{ "Adjacent_find", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Adjacent_find(data, data + size) - data; },
+				[](T* data, T*, size_t size) -> size_t { return std::adjacent_find(data, data + size) - data; }, Same_result<T> },
+			{ "Copy", 0, true, nullptr,
+				[](T* data, T* scratch, size_t size) -> size_t { return DVTL::Copy(data, data + size, scratch) - scratch; },
+				[](T* data, T* scratch, size_t size) -> size_t { return std::copy(data, data + size, scratch) - scratch; }, nullptr },
+			{ "Copy_if", 0, true, nullptr,
+				[](T* data, T* scratch, size_t size) -> size_t { return DVTL::Copy_if(data, data + size, scratch, Is_multiple_of_3<T>) - scratch; },
+				[](T* data, T* scratch, size_t size) -> size_t { return std::copy_if(data, data + size, scratch, Is_multiple_of_3<T>) - scratch; }, nullptr },
+			{ "Transform", 0, true, nullptr,
+				[](T* data, T* scratch, size_t size) -> size_t { return DVTL::Transform(data, data + size, scratch, Twice<T>) - scratch; },
+				[](T* data, T* scratch, size_t size) -> size_t { return std::transform(data, data + size, scratch, Twice<T>) - scratch; }, nullptr },
+			{ "Fill", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Fill(data, data + size, Make_value<T>(7)); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::fill(data, data + size, Make_value<T>(7)); return 0; }, nullptr },
+			{ "Replace", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { T old = data[0]; DVTL::Replace(data, data + size, old, Make_value<T>(-1)); return 0; },
+				[](T* data, T*, size_t size) -> size_t { T old = data[0]; std::replace(data, data + size, old, Make_value<T>(-1)); return 0; }, nullptr },
+			{ "Reverse", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Reverse(data, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::reverse(data, data + size); return 0; }, nullptr },
+			{ "Rotate", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Rotate(data, data + size / 3, data + size); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::rotate(data, data + size / 3, data + size); return 0; }, nullptr },
+			{ "Unique", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Unique(data, data + size) - data; },
+				[](T* data, T*, size_t size) -> size_t { return std::unique(data, data + size) - data; }, Same_prefix<T> },
+			{ "Remove", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { T value = data[size / 2]; return DVTL::Remove(data, data + size, value) - data; },
+				[](T* data, T*, size_t size) -> size_t { T value = data[size / 2]; return std::remove(data, data + size, value) - data; }, Same_prefix<T> },
+			{ "Remove_if", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Remove_if(data, data + size, Is_multiple_of_3<T>) - data; },
+				[](T* data, T*, size_t size) -> size_t { return std::remove_if(data, data + size, Is_multiple_of_3<T>) - data; }, Same_prefix<T> },
+			{ "Partition", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { return DVTL::Partition(data, data + size, Is_multiple_of_3<T>) - data; },
+				[](T* data, T*, size_t size) -> size_t { return std::partition(data, data + size, Is_multiple_of_3<T>) - data; }, Is_partition_result<T> },
+			{ "Stable_partition", 0, false, nullptr,
+				[](T* data, T*, size_t size) -> size_t { DVTL::Stable_partition(data, data + size, Is_multiple_of_3<T>); return 0; },
+				[](T* data, T*, size_t size) -> size_t { std::stable_partition(data, data + size, Is_multiple_of_3<T>); return 0; }, nullptr },
+		};
+
+		return cases;
+	}
+
+	struct Measurement
+	{
+		double seconds;		//best time of one block
+		size_t result;
+		std::vector<unsigned char> data;
+		std::vector<unsigned char> scratch;
+	};
+
+	//blocks of small inputs are repeated so every measurement covers at least 65536 elements
+	template<typename T>
+	Measurement Measure(Run<T> run, const std::vector<T>& input, bool usesScratch, int repeats)
+	{
+		size_t size = input.size();
+		size_t blocks = std::max<size_t>(1, (size_t(1) << 16) / size);
+
+		std::vector<T> data(blocks * size);
+		std::vector<T> scratch(usesScratch ? blocks * size : 0, Make_value<T>(0));
+
+		Measurement measurement{ std::numeric_limits<double>::max(), 0, {}, {} };
+
+		for (int repeat = 0; repeat < repeats; ++repeat)
+		{
+			for (size_t block = 0; block < blocks; ++block)
+				std::copy(input.begin(), input.end(), data.begin() + block * size);
+
+			auto start = std::chrono::steady_clock::now();
+			for (size_t block = 0; block < blocks; ++block)
+			{
+				size_t result = run(data.data() + block * size, usesScratch ? scratch.data() + block * size : nullptr, size);
+				if (block == 0) measurement.result = result;
+				Bench::Keep(result);
+			}
+			measurement.seconds = std::min(measurement.seconds, Bench::Seconds_since(start) / static_cast<double>(blocks));
+		}
+
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data());
+		measurement.data.assign(bytes, bytes + size * sizeof(T));
+		if (usesScratch)
+		{
+			bytes = reinterpret_cast<const unsigned char*>(scratch.data());
+			measurement.scratch.assign(bytes, bytes + size * sizeof(T));
+		}
+
+		return measurement;
+	}
+
+	template<typename T>
+	bool Same(const Case<T>& benchCase, const Measurement& dvtl, const Measurement& reference, size_t size)
+	{
+		const T* data = reinterpret_cast<const T*>(dvtl.data.data());
+		const T* scratch = reinterpret_cast<const T*>(dvtl.scratch.data());
+		const T* expectedData = reinterpret_cast<const T*>(reference.data.data());
+		const T* expectedScratch = reinterpret_cast<const T*>(reference.scratch.data());
+
+		if (benchCase.check != nullptr)
+			return benchCase.check(data, scratch, dvtl.result, expectedData, expectedScratch, reference.result, size);
+
+		return dvtl.result == reference.result && std::equal(data, data + size, expectedData) &&
+			(!benchCase.usesScratch || std::equal(scratch, scratch + std::min(dvtl.result, size), expectedScratch));
+	}
+
+	template<typename T>
+	void Run_type(const Bench::Options& options, Bench::Report& report)
+	{
+		std::vector<size_t> sizes = Bench::Sizes(options);
+
+		for (const Case<T>& benchCase : Make_cases<T>())
+		{
+			for (Distribution distribution : distributions)
+			{
+				std::string name = std::string(benchCase.name) + "/" + Type_name<T>() + "/" + Distribution_name(distribution);
+				if (!Bench::Selected(options, name)) continue;
+
+				for (size_t size : sizes)
+				{
+					if (benchCase.maxSize != 0 && size > benchCase.maxSize) break;
+
+					std::vector<long long> keys = Make_keys(distribution, size);
+					std::vector<T> input;
+					input.reserve(size);
+					for (long long key : keys)
+						input.push_back(Make_value<T>(key));
+
+					if (benchCase.prepare != nullptr)
+						benchCase.prepare(input);
+
+					Measurement dvtl = Measure(benchCase.dvtl, input, benchCase.usesScratch, options.repeats);
+					Measurement reference = Measure(benchCase.reference, input, benchCase.usesScratch, options.repeats);
+
+					bool valid = Same(benchCase, dvtl, reference, size);
+					double elements = static_cast<double>(size);
+					double ratio = dvtl.seconds / std::max(reference.seconds, 1e-12);
+
+					Bench::Row row;
+					row.key = name + "/" + std::to_string(size);
+					row.ratio = ratio;
+					row.valid = valid;
+					row.fields = {
+						{ "algorithm", benchCase.name, false },
+						{ "type", Type_name<T>(), false },
+						{ "distribution", Distribution_name(distribution), false },
+						{ "size", std::to_string(size), true },
+						{ "dvtl_ns_per_element", Bench::Format(dvtl.seconds * 1e9 / elements), true },
+						{ "std_ns_per_element", Bench::Format(reference.seconds * 1e9 / elements), true },
+						{ "ratio", Bench::Format(ratio), true },
+						{ "valid", valid ? "true" : "false", true },
+					};
+					report.Add(row);
+
+					//the next size is ten times larger, stop before a case runs away
+					if (std::max(dvtl.seconds, reference.seconds) * 10 > options.budgetSeconds) break;
+				}
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Bench::Options options;
+	int exitCode = 0;
+	if (!Bench::Parse_options(argc, argv, options, exitCode)) return exitCode;
+
+	Bench::Report report;
+	report.Print_header({ "algorithm", "type", "distribution", "size", "dvtl ns/elem", "std ns/elem", "ratio", "valid" });
+
+	Run_type<int>(options, report);
+	Run_type<double>(options, report);
+	Run_type<Record64>(options, report);
+
+	return Bench::Finish(report, options, "algorithm");
+}
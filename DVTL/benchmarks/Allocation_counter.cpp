@@ -0,0 +1,32 @@
+#include <cstdlib>
+#include <new>
+
+#include "Allocation_counter.h"
+
+namespace
+{
+	size_t allocations = 0;
+}
+
+size_t Bench::Allocation_count()
+{
+	return allocations;
+}
+
+void* operator new(size_t size)
+{
+	++allocations;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
@@ -0,0 +1,13 @@
+#ifndef DVTL_ALLOCATION_COUNTER_H
+#define DVTL_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+//the executables that link Allocation_counter.cpp replace the global operator new
+//and count every heap allocation of the process
+namespace Bench
+{
+	size_t Allocation_count();
+}
+
+#endif // !DVTL_ALLOCATION_COUNTER_H
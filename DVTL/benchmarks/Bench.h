@@ -0,0 +1,323 @@
+#ifndef DVTL_BENCH_H
+#define DVTL_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//shared harness of the benchmark executables: command line, timing, CSV/JSON output and regression checks;
+//every measured row carries a ratio of DVTL time to std time, lower is better
+namespace Bench
+{
+	struct Options
+	{
+		size_t minSize = 10;
+		size_t maxSize = 1000000;
+		int repeats = 3;
+		double budgetSeconds = 2.0;		//larger sizes of a case are skipped once one run takes longer
+		double maxRatio = 0;			//0 disables the absolute threshold
+		double tolerance = 0.25;		//allowed growth of a ratio over the baseline
+		bool strict = false;			//results that differ from std also fail the run
+		std::string filter;
+		std::string csvPath;
+		std::string jsonPath;
+		std::string baselinePath;
+	};
+
+	inline void Print_usage(const char* name)
+	{
+		std::printf(
+			"usage: %s [options]\n"
+			"  --min-size N       smallest input size, sizes are powers of ten (default 10)\n"
+			"  --max-size N       largest input size, up to 100000000 (default 1000000)\n"
+			"  --repeats N        measurements per case, the best is reported (default 3)\n"
+			"  --budget SECONDS   skip larger sizes once one run of a case exceeds this (default 2)\n"
+			"  --filter TEXT      only run cases whose name contains TEXT\n"
+			"  --csv PATH         write results as CSV\n"
+			"  --json PATH        write results as JSON\n"
+			"  --max-ratio R      fail when a DVTL/std time ratio exceeds R\n"
+			"  --baseline PATH    fail when a ratio grows over the ratio in a previous CSV\n"
+			"  --tolerance T      allowed relative growth over the baseline (default 0.25)\n"
+			"  --strict           fail when a result differs from std\n", name);
+	}
+
+	//returns false when the program should exit
+	inline bool Parse_options(int argc, char** argv, Options& options, int& exitCode)
+	{
+		exitCode = 0;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string argument = argv[i];
+			const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+			bool needsValue = argument != "--strict" && argument != "--help" && argument != "-h";
+
+			if (needsValue && value == nullptr)
+			{
+				std::fprintf(stderr, "missing value for %s\n", argument.c_str());
+				exitCode = 2;
+				return false;
+			}
+
+			if (argument == "--min-size")			options.minSize = std::strtoull(value, nullptr, 10);
+			else if (argument == "--max-size")		options.maxSize = std::strtoull(value, nullptr, 10);
+			else if (argument == "--repeats")		options.repeats = std::max(1, std::atoi(value));
+			else if (argument == "--budget")		options.budgetSeconds = std::atof(value);
+			else if (argument == "--filter")		options.filter = value;
+			else if (argument == "--csv")			options.csvPath = value;
+			else if (argument == "--json")			options.jsonPath = value;
+			else if (argument == "--max-ratio")		options.maxRatio = std::atof(value);
+			else if (argument == "--baseline")		options.baselinePath = value;
+			else if (argument == "--tolerance")		options.tolerance = std::atof(value);
+			else if (argument == "--strict")		{ options.strict = true; continue; }
+			else if (argument == "--help" || argument == "-h")
+			{
+				Print_usage(argv[0]);
+				return false;
+			}
+			else
+			{
+				std::fprintf(stderr, "unknown option %s\n", argument.c_str());
+				Print_usage(argv[0]);
+				exitCode = 2;
+				return false;
+			}
+
+			++i;
+		}
+
+		return true;
+	}
+
+	inline std::vector<size_t> Sizes(const Options& options)
+	{
+		std::vector<size_t> sizes;
+		for (size_t size = 10; size <= options.maxSize && size <= 100000000; size *= 10)
+			if (size >= options.minSize)
+				sizes.push_back(size);
+
+		return sizes;
+	}
+
+	inline bool Selected(const Options& options, const std::string& name)
+	{
+		return options.filter.empty() || name.find(options.filter) != std::string::npos;
+	}
+
+	//keeps results alive so the measured calls are not optimized away
+	inline volatile size_t sink = 0;
+
+	inline void Keep(size_t value)
+	{
+		sink = sink + value;
+	}
+
+	inline double Seconds_since(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	struct Field
+	{
+		std::string name;
+		std::string value;
+		bool numeric;
+	};
+
+	//key identifies the row across runs for baseline comparison
+	struct Row
+	{
+		std::string key;
+		std::vector<Field> fields;
+		double ratio;
+		bool valid;
+	};
+
+	inline std::string Format(double value)
+	{
+		char buffer[64];
+		std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+		return buffer;
+	}
+
+	class Report
+	{
+	public:
+		void Add(const Row& row)
+		{
+			m_rows.push_back(row);
+
+			for (size_t i = 0; i < row.fields.size(); ++i)
+				std::printf(i == 0 ? "%-22s" : " %14s", row.fields[i].value.c_str());
+			std::printf("\n");
+			std::fflush(stdout);
+		}
+
+		void Print_header(const std::vector<std::string>& names) const
+		{
+			for (size_t i = 0; i < names.size(); ++i)
+				std::printf(i == 0 ? "%-22s" : " %14s", names[i].c_str());
+			std::printf("\n");
+		}
+
+		bool Write_csv(const std::string& path) const
+		{
+			std::ofstream file(path);
+			if (!file) return false;
+
+			if (!m_rows.empty())
+			{
+				file << "key";
+				for (const Field& field : m_rows.front().fields)
+					file << ',' << field.name;
+				file << '\n';
+			}
+
+			for (const Row& row : m_rows)
+			{
+				file << row.key;
+				for (const Field& field : row.fields)
+					file << ',' << field.value;
+				file << '\n';
+			}
+
+			return static_cast<bool>(file);
+		}
+
+		bool Write_json(const std::string& path, const std::string& benchmark) const
+		{
+			std::ofstream file(path);
+			if (!file) return false;
+
+			file << "{\n  \"benchmark\": \"" << benchmark << "\",\n  \"results\": [";
+			for (size_t i = 0; i < m_rows.size(); ++i)
+			{
+				file << (i == 0 ? "\n" : ",\n") << "    {\"key\": \"" << m_rows[i].key << '"';
+				for (const Field& field : m_rows[i].fields)
+				{
+					file << ", \"" << field.name << "\": ";
+					if (field.numeric)
+						file << field.value;
+					else
+						file << '"' << field.value << '"';
+				}
+				file << '}';
+			}
+			file << "\n  ]\n}\n";
+
+			return static_cast<bool>(file);
+		}
+
+		//prints every threshold violation and returns their count
+		int Check(const Options& options) const
+		{
+			int failures = 0;
+			std::map<std::string, double> baseline;
+
+			if (!options.baselinePath.empty() && !readBaseline(options.baselinePath, baseline))
+			{
+				std::fprintf(stderr, "cannot read baseline %s\n", options.baselinePath.c_str());
+				++failures;
+			}
+
+			for (const Row& row : m_rows)
+			{
+				if (!row.valid)
+				{
+					std::printf("%s %s: result differs from std\n", options.strict ? "FAIL" : "note", row.key.c_str());
+					if (options.strict) ++failures;
+				}
+
+				if (row.ratio <= 0) continue;
+
+				if (options.maxRatio > 0 && row.ratio > options.maxRatio)
+				{
+					std::printf("FAIL %s: ratio %.3f exceeds %.3f\n", row.key.c_str(), row.ratio, options.maxRatio);
+					++failures;
+				}
+
+				auto previous = baseline.find(row.key);
+				if (previous != baseline.end() && previous->second > 0 && row.ratio > previous->second * (1 + options.tolerance))
+				{
+					std::printf("FAIL %s: ratio %.3f regressed from baseline %.3f\n", row.key.c_str(), row.ratio, previous->second);
+					++failures;
+				}
+			}
+
+			return failures;
+		}
+	private:
+		std::vector<Row> m_rows;
+
+		static bool readBaseline(const std::string& path, std::map<std::string, double>& baseline)
+		{
+			std::ifstream file(path);
+			if (!file) return false;
+
+			std::string line;
+			if (!std::getline(file, line)) return false;
+
+			std::vector<std::string> header = split(line);
+			size_t ratioColumn = std::find(header.begin(), header.end(), "ratio") - header.begin();
+			if (ratioColumn == header.size()) return false;
+
+			while (std::getline(file, line))
+			{
+				std::vector<std::string> cells = split(line);
+				if (cells.size() > ratioColumn && !cells[ratioColumn].empty())
+					baseline[cells[0]] = std::atof(cells[ratioColumn].c_str());
+			}
+
+			return true;
+		}
+
+		static std::vector<std::string> split(const std::string& line)
+		{
+			std::vector<std::string> cells;
+			std::stringstream stream(line);
+			std::string cell;
+
+			while (std::getline(stream, cell, ','))
+				cells.push_back(cell);
+
+			return cells;
+		}
+	};
+
+	//writes the requested files and applies the thresholds, returns the process exit code
+	inline int Finish(const Report& report, const Options& options, const std::string& benchmark)
+	{
+		int exitCode = 0;
+
+		if (!options.csvPath.empty() && !report.Write_csv(options.csvPath))
+		{
+			std::fprintf(stderr, "cannot write %s\n", options.csvPath.c_str());
+			exitCode = 2;
+		}
+
+		if (!options.jsonPath.empty() && !report.Write_json(options.jsonPath, benchmark))
+		{
+			std::fprintf(stderr, "cannot write %s\n", options.jsonPath.c_str());
+			exitCode = 2;
+		}
+
+		int failures = report.Check(options);
+		if (failures != 0)
+		{
+			std::printf("%d threshold violations\n", failures);
+			exitCode = 1;
+		}
+
+		return exitCode;
+	}
+}
+
+#endif // !DVTL_BENCH_H
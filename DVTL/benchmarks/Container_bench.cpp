@@ -0,0 +1,720 @@
+//measures Vector, Map, Compact_map, BTree_map, Flat_map and Flat_set against std::vector, std::map and std::set,
+//and Hash_map against std::unordered_map, on the same operations and counts
+//the heap allocations, copies and moves every operation triggers;
+//build with CMake from the repository root and run dvtl_bench_containers --help for the options
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <unordered_map>
+
+#include "BTree_map.h"
+#include "Compact_map.h"
+#include "Flat_map.h"
+#include "Flat_set.h"
+#include "Hash_map.h"
+#include "Map.h"
+#include "Vector.h"
+#include "Allocation_counter.h"
+#include "Bench.h"
+
+namespace
+{
+	struct Counters
+	{
+		size_t allocations;
+		size_t copies;
+		size_t moves;
+	};
+
+	//allocations are read from Bench::Allocation_count when a measurement starts and ends
+	Counters counters = { 0, 0, 0 };
+
+	Counters Snapshot()
+	{
+		Counters snapshot = counters;
+		snapshot.allocations = Bench::Allocation_count();
+		return snapshot;
+	}
+
+	//64-byte element that reports every copy and move
+	struct Tracked
+	{
+		long long key;
+		long long payload[7];
+
+		Tracked() :key(0), payload{} {}
+		explicit Tracked(long long key) :key(key)
+		{
+			for (long long i = 0; i < 7; ++i)
+				payload[i] = key ^ i;
+		}
+
+		Tracked(const Tracked& right) :key(right.key) { copyPayload(right); ++counters.copies; }
+		Tracked(Tracked&& right) noexcept :key(right.key) { copyPayload(right); ++counters.moves; }
+		Tracked& operator=(const Tracked& right) { key = right.key; copyPayload(right); ++counters.copies; return *this; }
+		Tracked& operator=(Tracked&& right) noexcept { key = right.key; copyPayload(right); ++counters.moves; return *this; }
+
+		bool operator<(const Tracked& right) const { return key < right.key; }
+		bool operator>(const Tracked& right) const { return key > right.key; }
+		bool operator==(const Tracked& right) const { return key == right.key; }
+	private:
+		void copyPayload(const Tracked& right)
+		{
+			for (int i = 0; i < 7; ++i)
+				payload[i] = right.payload[i];
+		}
+	};
+
+	//creation, identity and in-place construction arguments of the measured element types
+	template<typename T> struct Element;
+
+	template<>
+	struct Element<int>
+	{
+		static const char* Name() { return "int"; }
+		static bool Tracks_copies() { return false; }
+		static int Make(long long key) { return static_cast<int>(key); }
+		static long long Key(int value) { return value; }
+		template<typename T_Emplace> static void Emplace(T_Emplace emplace, long long key) { emplace(static_cast<int>(key)); }
+	};
+
+	template<>
+	struct Element<Tracked>
+	{
+		static const char* Name() { return "tracked64"; }
+		static bool Tracks_copies() { return true; }
+		static Tracked Make(long long key) { return Tracked(key); }
+		static long long Key(const Tracked& value) { return value.key; }
+		template<typename T_Emplace> static void Emplace(T_Emplace emplace, long long key) { emplace(key); }
+	};
+
+	//24 characters, too long for the small string buffer so every string owns an allocation
+	template<>
+	struct Element<std::string>
+	{
+		static const char* Name() { return "string"; }
+		static bool Tracks_copies() { return false; }
+		static std::string Make(long long key)
+		{
+			char buffer[32];
+			std::snprintf(buffer, sizeof(buffer), "key-%020lld", key);
+			return buffer;
+		}
+		static long long Key(const std::string& value)
+		{
+			unsigned long long hash = 14695981039346656037ull;
+			for (char symbol : value)
+				hash = (hash ^ static_cast<unsigned char>(symbol)) * 1099511628211ull;
+			return static_cast<long long>(hash);
+		}
+		template<typename T_Emplace> static void Emplace(T_Emplace emplace, long long key) { emplace(size_t(24), static_cast<char>('a' + key % 26)); }
+	};
+
+	inline size_t Combine(size_t seed, long long value)
+	{
+		return seed * 1000003 + static_cast<size_t>(value);
+	}
+
+	//the hash tables on both sides use the same hash so the rows compare the tables alone
+	template<typename T>
+	struct Element_hash
+	{
+		size_t operator()(const T& value) const { return DVTL::Hash<T>()(value); }
+	};
+
+	template<>
+	struct Element_hash<Tracked>
+	{
+		size_t operator()(const Tracked& value) const { return DVTL::Hash<long long>()(value.key); }
+	};
+
+	//distinct keys in random order
+	std::vector<long long> Make_keys(size_t size, unsigned seed)
+	{
+		std::vector<long long> keys(size);
+		for (size_t i = 0; i < size; ++i)
+			keys[i] = static_cast<long long>(i) * 7 + 3;
+
+		std::mt19937_64 generator(size * 31 + seed);
+		std::shuffle(keys.begin(), keys.end(), generator);
+		return keys;
+	}
+
+	struct Measurement
+	{
+		double seconds;		//best time of one block
+		Counters counts;	//per block
+		size_t result;		//of the first block
+		size_t digest;		//of the first block after the run
+	};
+
+	//setup and destruction of the states stay outside the timer, blocks of small sizes are repeated
+	template<typename T_State, typename T_Setup, typename T_Run, typename T_Digest>
+	Measurement Measure(size_t blocks, int repeats, T_Setup setup, T_Run run, T_Digest digest)
+	{
+		Measurement measurement{ std::numeric_limits<double>::max(), { 0, 0, 0 }, 0, 0 };
+
+		for (int repeat = 0; repeat < repeats; ++repeat)
+		{
+			std::vector<std::unique_ptr<T_State>> states;
+			states.reserve(blocks);
+			for (size_t block = 0; block < blocks; ++block)
+			{
+				states.push_back(std::unique_ptr<T_State>(new T_State()));
+				setup(*states.back());
+			}
+
+			Counters before = Snapshot();
+			auto start = std::chrono::steady_clock::now();
+			for (size_t block = 0; block < blocks; ++block)
+			{
+				size_t result = run(*states[block]);
+				if (block == 0) measurement.result = result;
+				Bench::Keep(result);
+			}
+			double seconds = Bench::Seconds_since(start) / static_cast<double>(blocks);
+			Counters after = Snapshot();
+
+			measurement.counts.allocations = (after.allocations - before.allocations) / blocks;
+			measurement.counts.copies = (after.copies - before.copies) / blocks;
+			measurement.counts.moves = (after.moves - before.moves) / blocks;
+			measurement.seconds = std::min(measurement.seconds, seconds);
+			measurement.digest = digest(*states.front());
+		}
+
+		return measurement;
+	}
+
+	//one measured operation: the DVTL and the std container run the same keys
+	struct Case
+	{
+		const char* name;
+		size_t maxSize;		//caps operations that are linear per call
+	};
+
+	const Case vectorCases[] = {
+		{ "Push_back", 0 },
+		{ "Emplace_back", 0 },
+		{ "Reserve_push_back", 0 },
+		{ "Inset_front", 10000 },
+		{ "Erase_front", 10000 },
+		{ "Copy", 0 },
+	};
+
+	const Case mapCases[] = {
+		{ "Insert", 0 },
+		{ "Find", 0 },
+		{ "Erase", 0 },
+		{ "Iterate", 0 },
+	};
+
+	//one insert or erase shifts the entries after it in the flat containers
+	const Case flatCases[] = {
+		{ "Insert", 10000 },
+		{ "Find", 0 },
+		{ "Erase", 10000 },
+		{ "Iterate", 0 },
+	};
+
+	//iteration order of hash tables is unspecified, churn erases one key and inserts another per operation
+	const Case hashCases[] = {
+		{ "Insert", 0 },
+		{ "Find", 0 },
+		{ "Erase", 0 },
+		{ "Churn", 0 },
+	};
+
+	template<typename T>
+	size_t Digest(const DVTL::Vector<T>& vector)
+	{
+		size_t digest = vector.Size();
+		for (size_t i = 0; i < vector.Size(); ++i)
+			digest = Combine(digest, Element<T>::Key(vector[i]));
+		return digest;
+	}
+
+	template<typename T>
+	size_t Digest(const std::vector<T>& vector)
+	{
+		size_t digest = vector.size();
+		for (const T& value : vector)
+			digest = Combine(digest, Element<T>::Key(value));
+		return digest;
+	}
+
+	template<typename T, typename T_Map>
+	size_t Digest_map(const T_Map& map)
+	{
+		size_t digest = map.Size();
+		if (map.Empty()) return digest;
+
+		for (auto it = map.Begin(); it != map.End(); ++it)
+			digest = Combine(Combine(digest, Element<T>::Key(it->First)), it->Second);
+		return digest;
+	}
+
+	template<typename T>
+	size_t Digest(const DVTL::Map<T, long long>& map)
+	{
+		return Digest_map<T>(map);
+	}
+
+	template<typename T>
+	size_t Digest(const DVTL::Compact_map<T, long long>& map)
+	{
+		return Digest_map<T>(map);
+	}
+
+	template<typename T>
+	size_t Digest(const DVTL::BTree_map<T, long long>& map)
+	{
+		return Digest_map<T>(map);
+	}
+
+	template<typename T>
+	size_t Digest(const DVTL::Flat_map<T, long long>& map)
+	{
+		return Digest_map<T>(map);
+	}
+
+	template<typename T>
+	size_t Digest(const std::map<T, long long>& map)
+	{
+		size_t digest = map.size();
+		for (const auto& entry : map)
+			digest = Combine(Combine(digest, Element<T>::Key(entry.first)), entry.second);
+		return digest;
+	}
+
+	template<typename T>
+	size_t Digest(const DVTL::Flat_set<T>& set)
+	{
+		size_t digest = set.Size();
+		for (auto it = set.Begin(); it != set.End(); ++it)
+			digest = Combine(digest, Element<T>::Key(*it));
+		return digest;
+	}
+
+	template<typename T>
+	size_t Digest(const std::set<T>& set)
+	{
+		size_t digest = set.size();
+		for (const T& key : set)
+			digest = Combine(digest, Element<T>::Key(key));
+		return digest;
+	}
+
+	//sum of the entry digests, independent of the iteration order
+	template<typename T, typename T_Map>
+	size_t Digest_hash_map(const T_Map& map)
+	{
+		size_t digest = map.Size();
+		for (auto it = map.Begin(); it != map.End(); ++it)
+			digest += Combine(Combine(0, Element<T>::Key(it->First)), it->Second);
+		return digest;
+	}
+
+	template<typename T>
+	size_t Digest(const DVTL::Hash_map<T, long long, Element_hash<T>>& map)
+	{
+		return Digest_hash_map<T>(map);
+	}
+
+	template<typename T>
+	size_t Digest(const std::unordered_map<T, long long, Element_hash<T>>& map)
+	{
+		size_t digest = map.size();
+		for (const auto& entry : map)
+			digest += Combine(Combine(0, Element<T>::Key(entry.first)), entry.second);
+		return digest;
+	}
+
+	template<typename T>
+	Measurement Measure_vector(const char* name, const std::vector<T>& values, const std::vector<long long>& keys, size_t blocks, int repeats)
+	{
+		typedef DVTL::Vector<T> Container;
+		std::string operation = name;
+		size_t size = values.size();
+
+		auto digest = [](const Container& vector) { return Digest(vector); };
+		auto none = [](Container&) {};
+		auto fill = [&](Container& vector) { for (const T& value : values) vector.Push_back(value); };
+
+		if (operation == "Push_back")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) { for (const T& value : values) vector.Push_back(value); return vector.Size(); }, digest);
+		if (operation == "Emplace_back")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) {
+				for (long long key : keys) Element<T>::Emplace([&](auto&&... args) { vector.Emplace_back(std::forward<decltype(args)>(args)...); }, key);
+				return vector.Size(); }, digest);
+		if (operation == "Reserve_push_back")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) { vector.Reserve(size); for (const T& value : values) vector.Push_back(value); return vector.Size(); }, digest);
+		if (operation == "Inset_front")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) { for (const T& value : values) vector.Inset(vector.CBegin(), value); return vector.Size(); }, digest);
+		if (operation == "Erase_front")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& vector) { while (!vector.Empty()) vector.Erase(vector.CBegin()); return vector.Size(); }, digest);
+
+		DVTL::Vector<T> source;
+		fill(source);
+		return Measure<Container>(blocks, repeats, none, [&](Container& vector) { vector = source; return vector.Size(); }, digest);
+	}
+
+	template<typename T>
+	Measurement Measure_std_vector(const char* name, const std::vector<T>& values, const std::vector<long long>& keys, size_t blocks, int repeats)
+	{
+		typedef std::vector<T> Container;
+		std::string operation = name;
+		size_t size = values.size();
+
+		auto digest = [](const Container& vector) { return Digest(vector); };
+		auto none = [](Container&) {};
+		auto fill = [&](Container& vector) { for (const T& value : values) vector.push_back(value); };
+
+		if (operation == "Push_back")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) { for (const T& value : values) vector.push_back(value); return vector.size(); }, digest);
+		if (operation == "Emplace_back")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) {
+				for (long long key : keys) Element<T>::Emplace([&](auto&&... args) { vector.emplace_back(std::forward<decltype(args)>(args)...); }, key);
+				return vector.size(); }, digest);
+		if (operation == "Reserve_push_back")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) { vector.reserve(size); for (const T& value : values) vector.push_back(value); return vector.size(); }, digest);
+		if (operation == "Inset_front")
+			return Measure<Container>(blocks, repeats, none, [&](Container& vector) { for (const T& value : values) vector.insert(vector.begin(), value); return vector.size(); }, digest);
+		if (operation == "Erase_front")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& vector) { while (!vector.empty()) vector.erase(vector.begin()); return vector.size(); }, digest);
+
+		std::vector<T> source;
+		fill(source);
+		return Measure<Container>(blocks, repeats, none, [&](Container& vector) { vector = source; return vector.size(); }, digest);
+	}
+
+	template<typename Container, typename T>
+	Measurement Measure_map(const char* name, const std::vector<T>& values, const std::vector<long long>& order, size_t blocks, int repeats)
+	{
+		std::string operation = name;
+
+		auto digest = [](const Container& map) { return Digest(map); };
+		auto none = [](Container&) {};
+		auto fill = [&](Container& map) { for (size_t i = 0; i < values.size(); ++i) map.Insert(values[i], static_cast<long long>(i)); };
+
+		if (operation == "Insert")
+			return Measure<Container>(blocks, repeats, none, [&](Container& map) { fill(map); return map.Size(); }, digest);
+		if (operation == "Find")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& map) {
+				size_t sum = 0;
+				for (long long index : order) sum += static_cast<size_t>(map.Find(values[index])->Second);
+				return sum; }, digest);
+		if (operation == "Erase")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& map) { for (long long index : order) map.Erase(values[index]); return map.Size(); }, digest);
+		if (operation == "Churn")
+		{
+			//a window over half of the keys slides once around all of them
+			size_t size = values.size();
+			size_t half = size / 2;
+			auto fillHalf = [&](Container& map) { for (size_t i = 0; i < half; ++i) map.Insert(values[i], static_cast<long long>(i)); };
+			return Measure<Container>(blocks, repeats, fillHalf, [&](Container& map) {
+				for (size_t i = 0; i < size; ++i) {
+					map.Erase(values[i]);
+					map.Insert(values[(i + half) % size], static_cast<long long>(i));
+				}
+				return map.Size(); }, digest);
+		}
+
+		return Measure<Container>(blocks, repeats, fill, [&](Container& map) {
+			size_t sum = 0;
+			for (auto it = map.Begin(); it != map.End(); ++it) sum = Combine(sum, it->Second);
+			return sum; }, digest);
+	}
+
+	template<typename T>
+	Measurement Measure_std_map(const char* name, const std::vector<T>& values, const std::vector<long long>& order, size_t blocks, int repeats)
+	{
+		typedef std::map<T, long long> Container;
+		std::string operation = name;
+
+		auto digest = [](const Container& map) { return Digest(map); };
+		auto none = [](Container&) {};
+		auto fill = [&](Container& map) { for (size_t i = 0; i < values.size(); ++i) map.emplace(values[i], static_cast<long long>(i)); };
+
+		if (operation == "Insert")
+			return Measure<Container>(blocks, repeats, none, [&](Container& map) { fill(map); return map.size(); }, digest);
+		if (operation == "Find")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& map) {
+				size_t sum = 0;
+				for (long long index : order) sum += static_cast<size_t>(map.find(values[index])->second);
+				return sum; }, digest);
+		if (operation == "Erase")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& map) { for (long long index : order) map.erase(values[index]); return map.size(); }, digest);
+
+		return Measure<Container>(blocks, repeats, fill, [&](Container& map) {
+			size_t sum = 0;
+			for (auto it = map.begin(); it != map.end(); ++it) sum = Combine(sum, it->second);
+			return sum; }, digest);
+	}
+
+	template<typename Container, typename T>
+	Measurement Measure_set(const char* name, const std::vector<T>& values, const std::vector<long long>& order, size_t blocks, int repeats)
+	{
+		std::string operation = name;
+
+		auto digest = [](const Container& set) { return Digest(set); };
+		auto none = [](Container&) {};
+		auto fill = [&](Container& set) { for (const T& value : values) set.Insert(value); };
+
+		if (operation == "Insert")
+			return Measure<Container>(blocks, repeats, none, [&](Container& set) { fill(set); return set.Size(); }, digest);
+		if (operation == "Find")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& set) {
+				size_t sum = 0;
+				for (long long index : order) sum += static_cast<size_t>(Element<T>::Key(*set.Find(values[index])));
+				return sum; }, digest);
+		if (operation == "Erase")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& set) { for (long long index : order) set.Erase(values[index]); return set.Size(); }, digest);
+
+		return Measure<Container>(blocks, repeats, fill, [&](Container& set) {
+			size_t sum = 0;
+			for (auto it = set.Begin(); it != set.End(); ++it) sum = Combine(sum, Element<T>::Key(*it));
+			return sum; }, digest);
+	}
+
+	template<typename T>
+	Measurement Measure_std_set(const char* name, const std::vector<T>& values, const std::vector<long long>& order, size_t blocks, int repeats)
+	{
+		typedef std::set<T> Container;
+		std::string operation = name;
+
+		auto digest = [](const Container& set) { return Digest(set); };
+		auto none = [](Container&) {};
+		auto fill = [&](Container& set) { for (const T& value : values) set.insert(value); };
+
+		if (operation == "Insert")
+			return Measure<Container>(blocks, repeats, none, [&](Container& set) { fill(set); return set.size(); }, digest);
+		if (operation == "Find")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& set) {
+				size_t sum = 0;
+				for (long long index : order) sum += static_cast<size_t>(Element<T>::Key(*set.find(values[index])));
+				return sum; }, digest);
+		if (operation == "Erase")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& set) { for (long long index : order) set.erase(values[index]); return set.size(); }, digest);
+
+		return Measure<Container>(blocks, repeats, fill, [&](Container& set) {
+			size_t sum = 0;
+			for (auto it = set.begin(); it != set.end(); ++it) sum = Combine(sum, Element<T>::Key(*it));
+			return sum; }, digest);
+	}
+
+	template<typename T>
+	Measurement Measure_std_unordered_map(const char* name, const std::vector<T>& values, const std::vector<long long>& order, size_t blocks, int repeats)
+	{
+		typedef std::unordered_map<T, long long, Element_hash<T>> Container;
+		std::string operation = name;
+
+		auto digest = [](const Container& map) { return Digest(map); };
+		auto none = [](Container&) {};
+		auto fill = [&](Container& map) { for (size_t i = 0; i < values.size(); ++i) map.emplace(values[i], static_cast<long long>(i)); };
+
+		if (operation == "Insert")
+			return Measure<Container>(blocks, repeats, none, [&](Container& map) { fill(map); return map.size(); }, digest);
+		if (operation == "Find")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& map) {
+				size_t sum = 0;
+				for (long long index : order) sum += static_cast<size_t>(map.find(values[index])->second);
+				return sum; }, digest);
+		if (operation == "Erase")
+			return Measure<Container>(blocks, repeats, fill, [&](Container& map) { for (long long index : order) map.erase(values[index]); return map.size(); }, digest);
+
+		size_t size = values.size();
+		size_t half = size / 2;
+		auto fillHalf = [&](Container& map) { for (size_t i = 0; i < half; ++i) map.emplace(values[i], static_cast<long long>(i)); };
+		return Measure<Container>(blocks, repeats, fillHalf, [&](Container& map) {
+			for (size_t i = 0; i < size; ++i) {
+				map.erase(values[i]);
+				map.emplace(values[(i + half) % size], static_cast<long long>(i));
+			}
+			return map.size(); }, digest);
+	}
+
+	template<typename T>
+	void Add_row(Bench::Report& report, const char* container, const char* operation, size_t size, const Measurement& dvtl, const Measurement& reference)
+	{
+		double operations = static_cast<double>(size);
+		double ratio = dvtl.seconds / std::max(reference.seconds, 1e-12);
+		bool valid = dvtl.result == reference.result && dvtl.digest == reference.digest;
+		bool tracked = Element<T>::Tracks_copies();
+
+		auto perOperation = [&](size_t count) { return Bench::Format(static_cast<double>(count) / operations); };
+		auto tracking = [&](size_t count) { return Bench::Field{ "", tracked ? perOperation(count) : "n/a", tracked }; };
+
+		Bench::Row row;
+		row.key = std::string(container) + "/" + operation + "/" + Element<T>::Name() + "/" + std::to_string(size);
+		row.ratio = ratio;
+		row.valid = valid;
+		row.fields = {
+			{ "container", container, false },
+			{ "operation", operation, false },
+			{ "type", Element<T>::Name(), false },
+			{ "size", std::to_string(size), true },
+			{ "dvtl_ns_per_op", Bench::Format(dvtl.seconds * 1e9 / operations), true },
+			{ "std_ns_per_op", Bench::Format(reference.seconds * 1e9 / operations), true },
+			{ "ratio", Bench::Format(ratio), true },
+			{ "dvtl_allocs_per_op", perOperation(dvtl.counts.allocations), true },
+			{ "std_allocs_per_op", perOperation(reference.counts.allocations), true },
+			tracking(dvtl.counts.copies),
+			tracking(reference.counts.copies),
+			tracking(dvtl.counts.moves),
+			tracking(reference.counts.moves),
+			{ "valid", valid ? "true" : "false", true },
+		};
+		row.fields[9].name = "dvtl_copies_per_op";
+		row.fields[10].name = "std_copies_per_op";
+		row.fields[11].name = "dvtl_moves_per_op";
+		row.fields[12].name = "std_moves_per_op";
+
+		report.Add(row);
+	}
+
+	template<typename T>
+	void Run_type(const Bench::Options& options, Bench::Report& report)
+	{
+		std::vector<size_t> sizes = Bench::Sizes(options);
+
+		for (const Case& benchCase : vectorCases)
+		{
+			std::string name = std::string("Vector/") + benchCase.name + "/" + Element<T>::Name();
+			if (!Bench::Selected(options, name)) continue;
+
+			for (size_t size : sizes)
+			{
+				if (benchCase.maxSize != 0 && size > benchCase.maxSize) break;
+
+				std::vector<long long> keys = Make_keys(size, 1);
+				std::vector<T> values;
+				values.reserve(size);
+				for (long long key : keys)
+					values.push_back(Element<T>::Make(key));
+
+				size_t blocks = std::max<size_t>(1, (size_t(1) << 14) / size);
+				Measurement dvtl = Measure_vector(benchCase.name, values, keys, blocks, options.repeats);
+				Measurement reference = Measure_std_vector(benchCase.name, values, keys, blocks, options.repeats);
+				Add_row<T>(report, "Vector", benchCase.name, size, dvtl, reference);
+
+				//the next size is ten times larger, stop before a case runs away
+				if (std::max(dvtl.seconds, reference.seconds) * 10 > options.budgetSeconds) break;
+			}
+		}
+
+		for (const Case& benchCase : mapCases)
+		{
+			std::string name = std::string("Map/") + benchCase.name + "/" + Element<T>::Name();
+			if (!Bench::Selected(options, name)) continue;
+
+			for (size_t size : sizes)
+			{
+				if (benchCase.maxSize != 0 && size > benchCase.maxSize) break;
+
+				std::vector<long long> keys = Make_keys(size, 2);
+				std::vector<T> values;
+				values.reserve(size);
+				for (long long key : keys)
+					values.push_back(Element<T>::Make(key));
+
+				//lookups and erases visit the keys in a different random order than the inserts
+				std::vector<long long> order(size);
+				for (size_t i = 0; i < size; ++i)
+					order[i] = static_cast<long long>(i);
+				std::shuffle(order.begin(), order.end(), std::mt19937_64(size));
+
+				size_t blocks = std::max<size_t>(1, (size_t(1) << 14) / size);
+				Measurement reference = Measure_std_map(benchCase.name, values, order, blocks, options.repeats);
+				Measurement dvtl = Measure_map<DVTL::Map<T, long long>>(benchCase.name, values, order, blocks, options.repeats);
+				Add_row<T>(report, "Map", benchCase.name, size, dvtl, reference);
+				Measurement compact = Measure_map<DVTL::Compact_map<T, long long>>(benchCase.name, values, order, blocks, options.repeats);
+				Add_row<T>(report, "Compact_map", benchCase.name, size, compact, reference);
+				Measurement btree = Measure_map<DVTL::BTree_map<T, long long>>(benchCase.name, values, order, blocks, options.repeats);
+				Add_row<T>(report, "BTree_map", benchCase.name, size, btree, reference);
+
+				if (std::max(dvtl.seconds, reference.seconds) * 10 > options.budgetSeconds) break;
+			}
+		}
+
+		for (const Case& benchCase : flatCases)
+		{
+			std::string name = std::string("Flat/") + benchCase.name + "/" + Element<T>::Name();
+			if (!Bench::Selected(options, name)) continue;
+
+			for (size_t size : sizes)
+			{
+				if (benchCase.maxSize != 0 && size > benchCase.maxSize) break;
+
+				std::vector<long long> keys = Make_keys(size, 4);
+				std::vector<T> values;
+				values.reserve(size);
+				for (long long key : keys)
+					values.push_back(Element<T>::Make(key));
+
+				std::vector<long long> order(size);
+				for (size_t i = 0; i < size; ++i)
+					order[i] = static_cast<long long>(i);
+				std::shuffle(order.begin(), order.end(), std::mt19937_64(size));
+
+				size_t blocks = std::max<size_t>(1, (size_t(1) << 14) / size);
+				Measurement mapReference = Measure_std_map(benchCase.name, values, order, blocks, options.repeats);
+				Measurement map = Measure_map<DVTL::Flat_map<T, long long>>(benchCase.name, values, order, blocks, options.repeats);
+				Add_row<T>(report, "Flat_map", benchCase.name, size, map, mapReference);
+				Measurement setReference = Measure_std_set(benchCase.name, values, order, blocks, options.repeats);
+				Measurement set = Measure_set<DVTL::Flat_set<T>>(benchCase.name, values, order, blocks, options.repeats);
+				Add_row<T>(report, "Flat_set", benchCase.name, size, set, setReference);
+
+				if (std::max(map.seconds, mapReference.seconds) * 10 > options.budgetSeconds) break;
+			}
+		}
+
+		for (const Case& benchCase : hashCases)
+		{
+			std::string name = std::string("Hash_map/") + benchCase.name + "/" + Element<T>::Name();
+			if (!Bench::Selected(options, name)) continue;
+
+			for (size_t size : sizes)
+			{
+				if (benchCase.maxSize != 0 && size > benchCase.maxSize) break;
+
+				std::vector<long long> keys = Make_keys(size, 3);
+				std::vector<T> values;
+				values.reserve(size);
+				for (long long key : keys)
+					values.push_back(Element<T>::Make(key));
+
+				std::vector<long long> order(size);
+				for (size_t i = 0; i < size; ++i)
+					order[i] = static_cast<long long>(i);
+				std::shuffle(order.begin(), order.end(), std::mt19937_64(size));
+
+				size_t blocks = std::max<size_t>(1, (size_t(1) << 14) / size);
+				Measurement reference = Measure_std_unordered_map(benchCase.name, values, order, blocks, options.repeats);
+				Measurement dvtl = Measure_map<DVTL::Hash_map<T, long long, Element_hash<T>>>(benchCase.name, values, order, blocks, options.repeats);
+				Add_row<T>(report, "Hash_map", benchCase.name, size, dvtl, reference);
+
+				if (std::max(dvtl.seconds, reference.seconds) * 10 > options.budgetSeconds) break;
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Bench::Options options;
+	int exitCode = 0;
+	if (!Bench::Parse_options(argc, argv, options, exitCode)) return exitCode;
+
+	Bench::Report report;
+	report.Print_header({ "container", "operation", "type", "size", "dvtl ns/op", "std ns/op", "ratio",
+		"dvtl allocs", "std allocs", "dvtl copies", "std copies", "dvtl moves", "std moves", "valid" });
+
+	Run_type<int>(options, report);
+	Run_type<Tracked>(options, report);
+	Run_type<std::string>(options, report);
+
+	return Bench::Finish(report, options, "containers");
+}
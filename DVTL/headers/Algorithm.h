@@ -3,8 +3,508 @@
 
 #include "Utility.h"
 #include "Initializer_list.h"
+#include "Vector.h"
+#include "Hash.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER) && defined(__x86_64__)
+#define DVTL_ALGORITHM_SIMD 1
+#define DVTL_SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#define DVTL_ALGORITHM_SIMD 1
+#define DVTL_SIMD_TARGET(isa)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#define DVTL_ALGORITHM_SIMD 0
+#endif
 
 namespace DVTL {
+	namespace Detail
+	{
+		template<typename T_Iterator> using Iterator_value_t = Remove_cvref_t<decltype(*Declval<T_Iterator&>())>;
+
+		//arithmetic elements behind a random access iterator are compacted without branches
+		template<typename T_Iterator, typename = void>
+		struct Is_branchless_compactable : False_type {};
+
+		template<typename T_Iterator>
+		struct Is_branchless_compactable<T_Iterator, Void_t<decltype(Declval<T_Iterator&>() += size_t(1))>>
+			: Bool_constant<Is_arithmetic_v<Iterator_value_t<T_Iterator>>> {};
+
+		constexpr size_t Compaction_block = 64;
+
+		template<typename T_IteratorInput, typename T_IteratorOutput, typename T_Predicate>
+		inline T_IteratorOutput copyIf(T_IteratorInput first, T_IteratorInput last, T_IteratorOutput output, T_Predicate& predicate, False_type)
+		{
+			while (first != last)
+			{
+				if (predicate(*first))
+				{
+					*output = *first;
+					++output;
+				}
+				++first;
+			}
+
+			return output;
+		}
+
+		template<typename T_IteratorInput, typename T_IteratorOutput, typename T_Predicate>
+		inline T_IteratorOutput copyIf(T_IteratorInput first, T_IteratorInput last, T_IteratorOutput output, T_Predicate& predicate, True_type)
+		{
+			Iterator_value_t<T_IteratorInput> buffer[Compaction_block];
+
+			while (first != last)
+			{
+				size_t count = 0;
+
+				for (size_t i = 0; i < Compaction_block && first != last; ++i, ++first)
+				{
+					auto value = *first;
+					buffer[count] = value;
+					count += static_cast<size_t>(static_cast<bool>(predicate(value)));
+				}
+
+				for (size_t i = 0; i < count; ++i, ++output)
+					*output = buffer[i];
+			}
+
+			return output;
+		}
+
+		template<typename T_Iterator, typename T_Predicate>
+		inline T_Iterator removeIf(T_Iterator first, T_Iterator last, T_Predicate& predicate, False_type)
+		{
+			T_Iterator it = first;
+
+			while (it != last)
+			{
+				if (predicate(*it))
+					++it;
+				else
+				{
+					if (first != it)
+						*first = Move(*it);
+					++first;
+					++it;
+				}
+			}
+
+			return first;
+		}
+
+		template<typename T_Iterator, typename T_Predicate>
+		inline T_Iterator removeIf(T_Iterator first, T_Iterator last, T_Predicate& predicate, True_type)
+		{
+			T_Iterator it = first;
+
+			while (it != last)
+			{
+				auto value = *it;
+				*first = value;
+				first += static_cast<size_t>(!predicate(value));
+				++it;
+			}
+
+			return first;
+		}
+
+		template<typename T_Iterator, typename T_Predicate>
+		inline T_Iterator unique(T_Iterator first, T_Iterator last, T_Predicate& keep, False_type)
+		{
+			T_Iterator result = first;
+			++first;
+
+			while (first != last) {
+				if (keep(*result, *first)) {
+					++result;
+					if (result != first)
+						*result = Move(*first);
+				}
+				++first;
+			}
+
+			return ++result;
+		}
+
+		template<typename T_Iterator, typename T_Predicate>
+		inline T_Iterator unique(T_Iterator first, T_Iterator last, T_Predicate& keep, True_type)
+		{
+			auto kept = *first;
+			T_Iterator result = first;
+			++result;
+			++first;
+
+			while (first != last) {
+				auto value = *first;
+				bool isKept = static_cast<bool>(keep(kept, value));
+
+				*result = value;
+				result += static_cast<size_t>(isKept);
+				kept = isKept ? value : kept;
+				++first;
+			}
+
+			return result;
+		}
+
+		//4 and 8 byte integers, float and double are compacted with vector instructions
+		template<typename T>
+		constexpr bool Is_simd_element_v = Is_arithmetic_v<T> && !Is_same_v<T, bool> && !Is_same_v<T, long double> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+		//such elements stored next to each other, behind a pointer or a Vector iterator
+		template<typename T_Iterator, typename T_Value = Iterator_value_t<T_Iterator>, bool = Is_simd_element_v<T_Value>>
+		struct Is_simd_compactable : False_type {};
+
+#if DVTL_ALGORITHM_SIMD
+		template<typename T_Iterator, typename T_Value>
+		struct Is_simd_compactable<T_Iterator, T_Value, true>
+			: Bool_constant<Is_same_v<T_Iterator, T_Value*> || Is_same_v<T_Iterator, typename Vector<T_Value>::iterator>> {};
+
+		enum Simd_level { Simd_none, Simd_avx2, Simd_avx512 };
+
+		//the kernels need popcnt next to the vector extension and an OS that saves the wide registers
+		inline Simd_level probeSimd()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) return Simd_none;
+
+			__cpuid(info, 1);
+			bool popcnt = (info[2] & (1 << 23)) != 0;
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			if (!popcnt || !osxsave) return Simd_none;
+
+			unsigned long long saved = _xgetbv(0);
+			__cpuidex(info, 7, 0);
+			if ((info[1] & (1 << 16)) != 0 && (saved & 0xE6) == 0xE6) return Simd_avx512;
+			if ((info[1] & (1 << 5)) != 0 && (saved & 0x06) == 0x06) return Simd_avx2;
+			return Simd_none;
+#else
+			__builtin_cpu_init();
+			if (!__builtin_cpu_supports("popcnt")) return Simd_none;
+			if (__builtin_cpu_supports("avx512f")) return Simd_avx512;
+			if (__builtin_cpu_supports("avx2")) return Simd_avx2;
+			return Simd_none;
+#endif
+		}
+
+		inline Simd_level simdLevel()
+		{
+			static const Simd_level level = probeSimd();
+			return level;
+		}
+
+		//entry i holds the positions of the set bits of i in consecutive bytes, the AVX2 kernels shuffle with it
+		struct Compress_table { unsigned long long entries[256]; };
+
+		constexpr Compress_table makeCompressTable()
+		{
+			Compress_table table{};
+			for (unsigned int mask = 0; mask < 256; ++mask) {
+				unsigned int count = 0;
+				for (unsigned int bit = 0; bit < 8; ++bit)
+					if (((mask >> bit) & 1u) != 0)
+						table.entries[mask] |= static_cast<unsigned long long>(bit) << (8 * count++);
+			}
+			return table;
+		}
+
+		constexpr Compress_table Compress_indices = makeCompressTable();
+
+		//lanes of a 256 bit register: Compress moves the lanes set in keep to the front, the rest is unspecified,
+		//Shift_in moves every lane one up and fills lane 0 from previous
+		struct Avx2_lanes_32
+		{
+			static constexpr size_t count = 8;
+			static constexpr unsigned int all = 0xFFu;
+
+			DVTL_SIMD_TARGET("avx2") static __m256i Compress(__m256i block, unsigned int keep)
+			{
+				__m256i indices = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(Compress_indices.entries[keep])));
+				return _mm256_permutevar8x32_epi32(block, indices);
+			}
+
+			DVTL_SIMD_TARGET("avx2") static __m256i Shift_in(__m256i block, __m256i previous)
+			{
+				__m256i rotated = _mm256_permutevar8x32_epi32(block, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+				return _mm256_blend_epi32(rotated, previous, 0x01);
+			}
+		};
+
+		struct Avx2_lanes_64
+		{
+			static constexpr size_t count = 4;
+			static constexpr unsigned int all = 0xFu;
+
+			//every kept lane is a pair of 32 bit lanes in the table
+			DVTL_SIMD_TARGET("avx2") static __m256i Compress(__m256i block, unsigned int keep)
+			{
+				unsigned int pairs = (keep & 1u) * 0x3u | (keep & 2u) * 0x6u | (keep & 4u) * 0xCu | (keep & 8u) * 0x18u;
+				return Avx2_lanes_32::Compress(block, pairs);
+			}
+
+			DVTL_SIMD_TARGET("avx2") static __m256i Shift_in(__m256i block, __m256i previous)
+			{
+				__m256i rotated = _mm256_permute4x64_epi64(block, _MM_SHUFFLE(2, 1, 0, 3));
+				return _mm256_blend_epi32(rotated, previous, 0x03);
+			}
+		};
+
+		//Equal sets bit i when lane i of both registers compares equal, with the == of the element type
+		template<size_t Size, bool Floating> struct Avx2_lanes;
+
+		template<> struct Avx2_lanes<4, false> : Avx2_lanes_32
+		{
+			template<typename T> DVTL_SIMD_TARGET("avx2") static __m256i Broadcast(T value) { return _mm256_set1_epi32(static_cast<int>(value)); }
+			DVTL_SIMD_TARGET("avx2") static unsigned int Equal(__m256i left, __m256i right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(left, right))));
+			}
+		};
+
+		template<> struct Avx2_lanes<8, false> : Avx2_lanes_64
+		{
+			template<typename T> DVTL_SIMD_TARGET("avx2") static __m256i Broadcast(T value) { return _mm256_set1_epi64x(static_cast<long long>(value)); }
+			DVTL_SIMD_TARGET("avx2") static unsigned int Equal(__m256i left, __m256i right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(left, right))));
+			}
+		};
+
+		template<> struct Avx2_lanes<4, true> : Avx2_lanes_32
+		{
+			DVTL_SIMD_TARGET("avx2") static __m256i Broadcast(float value) { return _mm256_castps_si256(_mm256_set1_ps(value)); }
+			DVTL_SIMD_TARGET("avx2") static unsigned int Equal(__m256i left, __m256i right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_castsi256_ps(left), _mm256_castsi256_ps(right), _CMP_EQ_OQ)));
+			}
+		};
+
+		template<> struct Avx2_lanes<8, true> : Avx2_lanes_64
+		{
+			DVTL_SIMD_TARGET("avx2") static __m256i Broadcast(double value) { return _mm256_castpd_si256(_mm256_set1_pd(value)); }
+			DVTL_SIMD_TARGET("avx2") static unsigned int Equal(__m256i left, __m256i right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_castsi256_pd(left), _mm256_castsi256_pd(right), _CMP_EQ_OQ)));
+			}
+		};
+
+		//lanes of a 512 bit register, the same operations on the compress instructions of AVX-512F;
+		//Shift_in uses the masked alignr, the plain one reads an undefined register that GCC warns about
+		struct Avx512_lanes_32
+		{
+			static constexpr size_t count = 16;
+			static constexpr unsigned int all = 0xFFFFu;
+
+			DVTL_SIMD_TARGET("avx512f") static __m512i Compress(__m512i block, unsigned int keep) { return _mm512_maskz_compress_epi32(static_cast<__mmask16>(keep), block); }
+			DVTL_SIMD_TARGET("avx512f") static __m512i Shift_in(__m512i block, __m512i previous) { return _mm512_maskz_alignr_epi32(0xFFFF, block, previous, 15); }
+		};
+
+		struct Avx512_lanes_64
+		{
+			static constexpr size_t count = 8;
+			static constexpr unsigned int all = 0xFFu;
+
+			DVTL_SIMD_TARGET("avx512f") static __m512i Compress(__m512i block, unsigned int keep) { return _mm512_maskz_compress_epi64(static_cast<__mmask8>(keep), block); }
+			DVTL_SIMD_TARGET("avx512f") static __m512i Shift_in(__m512i block, __m512i previous) { return _mm512_maskz_alignr_epi64(0xFF, block, previous, 7); }
+		};
+
+		template<size_t Size, bool Floating> struct Avx512_lanes;
+
+		template<> struct Avx512_lanes<4, false> : Avx512_lanes_32
+		{
+			template<typename T> DVTL_SIMD_TARGET("avx512f") static __m512i Broadcast(T value) { return _mm512_set1_epi32(static_cast<int>(value)); }
+			DVTL_SIMD_TARGET("avx512f") static unsigned int Equal(__m512i left, __m512i right) { return _mm512_cmpeq_epi32_mask(left, right); }
+		};
+
+		template<> struct Avx512_lanes<8, false> : Avx512_lanes_64
+		{
+			template<typename T> DVTL_SIMD_TARGET("avx512f") static __m512i Broadcast(T value) { return _mm512_set1_epi64(static_cast<long long>(value)); }
+			DVTL_SIMD_TARGET("avx512f") static unsigned int Equal(__m512i left, __m512i right) { return _mm512_cmpeq_epi64_mask(left, right); }
+		};
+
+		template<> struct Avx512_lanes<4, true> : Avx512_lanes_32
+		{
+			DVTL_SIMD_TARGET("avx512f") static __m512i Broadcast(float value) { return _mm512_castps_si512(_mm512_set1_ps(value)); }
+			DVTL_SIMD_TARGET("avx512f") static unsigned int Equal(__m512i left, __m512i right)
+			{
+				return _mm512_cmp_ps_mask(_mm512_castsi512_ps(left), _mm512_castsi512_ps(right), _CMP_EQ_OQ);
+			}
+		};
+
+		template<> struct Avx512_lanes<8, true> : Avx512_lanes_64
+		{
+			DVTL_SIMD_TARGET("avx512f") static __m512i Broadcast(double value) { return _mm512_castpd_si512(_mm512_set1_pd(value)); }
+			DVTL_SIMD_TARGET("avx512f") static unsigned int Equal(__m512i left, __m512i right)
+			{
+				return _mm512_cmp_pd_mask(_mm512_castsi512_pd(left), _mm512_castsi512_pd(right), _CMP_EQ_OQ);
+			}
+		};
+
+		//a whole register is loaded before its compressed lanes are stored, the store never passes the loaded block,
+		//so the ranges are compacted in place; the elements after the returned count are unspecified
+		template<typename T_Lanes, typename T>
+		DVTL_SIMD_TARGET("avx2,popcnt") inline size_t removeAvx2(T* data, size_t size, T value)
+		{
+			const __m256i removed = T_Lanes::Broadcast(value);
+			size_t kept = 0, i = 0;
+
+			for (; i + T_Lanes::count <= size; i += T_Lanes::count) {
+				__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+				unsigned int keep = T_Lanes::Equal(block, removed) ^ T_Lanes::all;
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + kept), T_Lanes::Compress(block, keep));
+				kept += static_cast<size_t>(_mm_popcnt_u32(keep));
+			}
+
+			for (; i < size; ++i) {
+				T element = data[i];
+				data[kept] = element;
+				kept += static_cast<size_t>(!(element == value));
+			}
+
+			return kept;
+		}
+
+		template<typename T_Lanes, typename T>
+		DVTL_SIMD_TARGET("avx512f,popcnt") inline size_t removeAvx512(T* data, size_t size, T value)
+		{
+			const __m512i removed = T_Lanes::Broadcast(value);
+			size_t kept = 0, i = 0;
+
+			for (; i + T_Lanes::count <= size; i += T_Lanes::count) {
+				__m512i block = _mm512_loadu_si512(data + i);
+				unsigned int keep = T_Lanes::Equal(block, removed) ^ T_Lanes::all;
+				_mm512_storeu_si512(data + kept, T_Lanes::Compress(block, keep));
+				kept += static_cast<size_t>(_mm_popcnt_u32(keep));
+			}
+
+			for (; i < size; ++i) {
+				T element = data[i];
+				data[kept] = element;
+				kept += static_cast<size_t>(!(element == value));
+			}
+
+			return kept;
+		}
+
+		//an element is kept when it differs from the one before it, which is the same as differing from the last kept one;
+		//the element before a block is carried in previous because the store of the block before may have overwritten it
+		template<typename T_Lanes, typename T>
+		DVTL_SIMD_TARGET("avx2,popcnt") inline size_t uniqueAvx2(T* data, size_t size)
+		{
+			T previous = data[0];
+			size_t kept = 1, i = 1;
+
+			for (; i + T_Lanes::count <= size; i += T_Lanes::count) {
+				__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+				unsigned int keep = T_Lanes::Equal(block, T_Lanes::Shift_in(block, T_Lanes::Broadcast(previous))) ^ T_Lanes::all;
+				previous = data[i + T_Lanes::count - 1];
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + kept), T_Lanes::Compress(block, keep));
+				kept += static_cast<size_t>(_mm_popcnt_u32(keep));
+			}
+
+			for (; i < size; ++i) {
+				T element = data[i];
+				data[kept] = element;
+				kept += static_cast<size_t>(!(element == previous));
+				previous = element;
+			}
+
+			return kept;
+		}
+
+		template<typename T_Lanes, typename T>
+		DVTL_SIMD_TARGET("avx512f,popcnt") inline size_t uniqueAvx512(T* data, size_t size)
+		{
+			T previous = data[0];
+			size_t kept = 1, i = 1;
+
+			for (; i + T_Lanes::count <= size; i += T_Lanes::count) {
+				__m512i block = _mm512_loadu_si512(data + i);
+				unsigned int keep = T_Lanes::Equal(block, T_Lanes::Shift_in(block, T_Lanes::Broadcast(previous))) ^ T_Lanes::all;
+				previous = data[i + T_Lanes::count - 1];
+				_mm512_storeu_si512(data + kept, T_Lanes::Compress(block, keep));
+				kept += static_cast<size_t>(_mm_popcnt_u32(keep));
+			}
+
+			for (; i < size; ++i) {
+				T element = data[i];
+				data[kept] = element;
+				kept += static_cast<size_t>(!(element == previous));
+				previous = element;
+			}
+
+			return kept;
+		}
+
+		//the widest instruction set of the processor, the branchless loop without one
+		template<typename T>
+		inline size_t removeSimd(T* data, size_t size, T value)
+		{
+			constexpr bool floating = Is_same_v<T, float> || Is_same_v<T, double>;
+
+			switch (simdLevel()) {
+			case Simd_avx512:	return removeAvx512<Avx512_lanes<sizeof(T), floating>>(data, size, value);
+			case Simd_avx2:		return removeAvx2<Avx2_lanes<sizeof(T), floating>>(data, size, value);
+			default: {
+				auto predicate = [&value](const T& element) { return element == value; };
+				return static_cast<size_t>(removeIf(data, data + size, predicate, True_type()) - data);
+			}
+			}
+		}
+
+		template<typename T>
+		inline size_t uniqueSimd(T* data, size_t size)
+		{
+			constexpr bool floating = Is_same_v<T, float> || Is_same_v<T, double>;
+
+			switch (simdLevel()) {
+			case Simd_avx512:	return uniqueAvx512<Avx512_lanes<sizeof(T), floating>>(data, size);
+			case Simd_avx2:		return uniqueAvx2<Avx2_lanes<sizeof(T), floating>>(data, size);
+			default: {
+				auto keep = [](const T& left, const T& right) { return left != right; };
+				return static_cast<size_t>(unique(data, data + size, keep, True_type()) - data);
+			}
+			}
+		}
+#endif
+
+		template<typename T_Iterator, typename T_Type>
+		inline T_Iterator remove(T_Iterator first, T_Iterator last, const T_Type& value, False_type)
+		{
+			auto predicate = [&value](const auto& element) { return element == value; };
+			return removeIf(first, last, predicate, Is_branchless_compactable<T_Iterator>());
+		}
+
+		template<typename T_Iterator>
+		inline T_Iterator unique(T_Iterator first, T_Iterator last, False_type)
+		{
+			auto keep = [](const auto& left, const auto& right) { return left != right; };
+			return unique(first, last, keep, Is_branchless_compactable<T_Iterator>());
+		}
+
+#if DVTL_ALGORITHM_SIMD
+		template<typename T_Iterator, typename T_Type>
+		inline T_Iterator remove(T_Iterator first, T_Iterator last, const T_Type& value, True_type)
+		{
+			if (first == last) return last;
+
+			first += removeSimd(&*first, static_cast<size_t>(last - first), value);
+			return first;
+		}
+
+		template<typename T_Iterator>
+		inline T_Iterator unique(T_Iterator first, T_Iterator last, True_type)
+		{
+			first += uniqueSimd(&*first, static_cast<size_t>(last - first));
+			return first;
+		}
+#endif
+	}
+
 	template<typename T_Iterator>
 	inline T_Iterator Adjacent_find(T_Iterator first, T_Iterator last)
 	{
@@ -70,7 +570,7 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator, typename T_Type>
-	inline bool Binary_search(T_Iterator first, T_Iterator last, const T_Type& value)
+	constexpr bool Binary_search(T_Iterator first, T_Iterator last, const T_Type& value)
 	{
 		while (first != last) {
 			T_Iterator middle(first + (last - first) / 2);
@@ -84,7 +584,7 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator, typename T_Type, typename T_Predicate>
-	inline bool Binary_search(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
+	constexpr bool Binary_search(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
 	{
 		while (first < last) {
 			T_Iterator middle(first + (last - first) / 2);
@@ -98,7 +598,7 @@ namespace DVTL {
 	}
 
 	template<typename T_IteratorInput, typename T_IteratorOutput>
-	inline T_IteratorOutput Copy(T_IteratorInput first, T_IteratorInput last, T_IteratorOutput output)
+	constexpr T_IteratorOutput Copy(T_IteratorInput first, T_IteratorInput last, T_IteratorOutput output)
 	{
 		while (first != last) 
 		{
@@ -126,17 +626,7 @@ namespace DVTL {
 	template<typename T_IteratorInput, typename T_IteratorOutput, typename T_Predicate>
 	inline T_IteratorOutput Copy_if(T_IteratorInput first, T_IteratorInput last, T_IteratorOutput output, T_Predicate predicate)
 	{
-		while (first != last)
-		{
-			if (predicate(*first))
-			{
-				*output = *first;
-				++output;
-			}
-			++first;
-		}
-
-		return output;
+		return Detail::copyIf(first, last, output, predicate, Bool_constant<Is_arithmetic_v<Detail::Iterator_value_t<T_IteratorInput>>>());
 	}
 
 	template<typename T_IteratorInput, typename T_IteratorOutput>
@@ -243,7 +733,7 @@ namespace DVTL {
 	}
 
 	template <typename T_Iterator, typename T_Type>
-	inline T_Iterator Upper_bound(T_Iterator first, T_Iterator last, const T_Type& value)
+	constexpr T_Iterator Upper_bound(T_Iterator first, T_Iterator last, const T_Type& value)
 	{
 		while (first < last)
 		{
@@ -257,7 +747,7 @@ namespace DVTL {
 	}
 
 	template <typename T_Iterator, typename T_Type, typename T_Predicate>
-	inline T_Iterator Upper_bound(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
+	constexpr T_Iterator Upper_bound(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
 	{
 		while (first < last)
 		{
@@ -271,7 +761,7 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator, typename T_Type>
-	inline T_Iterator Lower_bound(T_Iterator first, T_Iterator last, const T_Type& value)
+	constexpr T_Iterator Lower_bound(T_Iterator first, T_Iterator last, const T_Type& value)
 	{
 		while (first < last)
 		{
@@ -285,7 +775,7 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator, typename T_Type, typename T_Predicate>
-	inline T_Iterator Lower_bound(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
+	constexpr T_Iterator Lower_bound(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
 	{
 		while (first < last)
 		{
@@ -299,19 +789,19 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator, typename T_Type>
-	inline Pair<T_Iterator, T_Iterator> Equal_range(T_Iterator first, T_Iterator last, const T_Type& value)
+	constexpr Pair<T_Iterator, T_Iterator> Equal_range(T_Iterator first, T_Iterator last, const T_Type& value)
 	{
 		return Pair<T_Iterator, T_Iterator>(Lower_bound(first, last, value), Upper_bound(first, last, value));
 	}
 
 	template<typename T_Iterator, typename T_Type, typename T_Predicate>
-	inline Pair<T_Iterator, T_Iterator> Equal_range(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
+	constexpr Pair<T_Iterator, T_Iterator> Equal_range(T_Iterator first, T_Iterator last, const T_Type& value, T_Predicate predicate)
 	{
 		return Pair<T_Iterator, T_Iterator>(Lower_bound(first, last, value, predicate), Upper_bound(first, last, value, predicate));
 	}
 
 	template<typename T_Iterator, typename T_Type>
-	inline void Fill(T_Iterator first, T_Iterator last, const T_Type& value)
+	constexpr void Fill(T_Iterator first, T_Iterator last, const T_Type& value)
 	{
 		while (first != last)
 		{
@@ -575,15 +1065,15 @@ namespace DVTL {
 				++first;
 			else
 			{
-				auto value = *middle;
+				auto value = Move(*middle);
 				T_Iterator it = middle;
 
 				while (it != first)
 				{
-					*it = *(it - 1);
+					*it = Move(*(it - 1));
 					--it;
 				}
-				*first = value;
+				*first = Move(value);
 
 				++first;
 				++middle;
@@ -606,15 +1096,15 @@ namespace DVTL {
 				++first;
 			else
 			{
-				auto value = *middle;
+				auto value = Move(*middle);
 				T_Iterator it = middle;
 
 				while (it != first)
 				{
-					*it = *(it - 1);
+					*it = Move(*(it - 1));
 					--it;
 				}
-				*first = value;
+				*first = Move(value);
 
 				++first;
 				++middle;
@@ -839,11 +1329,11 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator1, typename T_Iterator2>
-	inline void Iter_swap(T_Iterator1 left, T_Iterator2 right)
+	constexpr void Iter_swap(T_Iterator1 left, T_Iterator2 right)
 	{
-		auto val = *left;
-		*left = *right;
-		*right = val;
+		auto val = Move(*left);
+		*left = Move(*right);
+		*right = Move(val);
 	}
 
 	template<typename T_Iterator1, typename T_Iterator2>
@@ -1195,54 +1685,236 @@ namespace DVTL {
 		return result;
 	}
 
-	template<typename T_Iterator1, typename T_Iterator2>
-	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2)
+	namespace Detail
 	{
-		while (first1 != last1 && *first1 == *first2)
+		//tournament tree over k sorted runs, node 0 holds the winner and nodes 1..k-1 the losers
+		template<typename T_Iterator, typename T_Predicate>
+		class Loser_tree
 		{
-			++first1;
-			++first2;
-		}
+		public:
+			template<typename T_RangeIterator>
+			Loser_tree(T_RangeIterator firstRange, T_RangeIterator lastRange, T_Predicate& predicate)
+				:m_count(static_cast<size_t>(lastRange - firstRange)), m_current(), m_last(), m_tree(m_count, m_count), m_predicate(predicate)
+			{
+				m_current.Reserve(m_count);
+				m_last.Reserve(m_count);
 
-		return Pair<T_Iterator1, T_Iterator2>(first1, first2);
-	}
+				for (; firstRange != lastRange; ++firstRange)
+				{
+					m_current.Push_back((*firstRange).First);
+					m_last.Push_back((*firstRange).Second);
+				}
 
-	template<typename T_Iterator1, typename T_Iterator2, typename T_Predicate>
-	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Predicate predicate)
-	{
-		while (first1 != last1 && predicate(*first1, *first2))
-		{
-			++first1;
-			++first2;
-		}
+				for (size_t i = 0; i < m_count; ++i)
+				{
+					size_t winner = i;
+					size_t node = (i + m_count) / 2;
 
-		return Pair<T_Iterator1, T_Iterator2>(first1, first2);
-	}
+					while (node > 0)
+					{
+						if (m_tree[node] == m_count)
+						{
+							m_tree[node] = winner;
+							winner = m_count;
+							break;
+						}
 
-	template<typename T_Iterator1, typename T_Iterator2>
-	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Iterator2 last2)
-	{
-		if ((last1 - first1) != (last2 - first2)) return Pair<T_Iterator1, T_Iterator2>(first1, first2);
+						if (beats(m_tree[node], winner))
+							exchange(m_tree[node], winner);
 
-			while (first1 != last1 && *first1 == *first2)
-			{
-				++first1;
-				++first2;
+						node /= 2;
+					}
+
+					if (winner != m_count)
+						m_tree[0] = winner;
+				}
 			}
 
-		return Pair<T_Iterator1, T_Iterator2>(first1, first2);
-	}
+			bool Empty() const { return m_count == 0 || m_current[m_tree[0]] == m_last[m_tree[0]]; }
+			T_Iterator& Top() { return m_current[m_tree[0]]; }
 
-	template<typename T_Iterator1, typename T_Iterator2, typename T_Predicate>
-	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Iterator2 last2, T_Predicate predicate)
-	{
-		if ((last1 - first1) != (last2 - first2)) return Pair<T_Iterator1, T_Iterator2>(first1, first2);
+			void Pop()
+			{
+				size_t winner = m_tree[0];
+				++m_current[winner];
 
-		while (first1 != last1 && predicate(*first1, *first2))
-		{
-			++first1;
-			++first2;
-		}
+				for (size_t node = (winner + m_count) / 2; node > 0; node /= 2)
+				{
+					if (beats(m_tree[node], winner))
+						exchange(m_tree[node], winner);
+				}
+
+				m_tree[0] = winner;
+			}
+		private:
+			size_t m_count;
+			Vector<T_Iterator> m_current;
+			Vector<T_Iterator> m_last;
+			Vector<size_t> m_tree;
+			T_Predicate& m_predicate;
+
+			//exhausted runs always lose, ties go to the lower run to keep the merge stable
+			bool beats(size_t left, size_t right)
+			{
+				if (m_current[left] == m_last[left]) return false;
+				if (m_current[right] == m_last[right]) return true;
+				if (left < right) return !m_predicate(*m_current[right], *m_current[left]);
+				return m_predicate(*m_current[left], *m_current[right]);
+			}
+
+			static void exchange(size_t& left, size_t& right)
+			{
+				size_t temp = left;
+				left = right;
+				right = temp;
+			}
+		};
+
+		//number of elements of the merged output that precede the element at position in run
+		template<typename T_RangeIterator, typename T_Iterator, typename T_Predicate>
+		inline size_t mergeRank(T_RangeIterator firstRange, T_RangeIterator lastRange, T_RangeIterator run, T_Iterator position, T_Predicate& predicate)
+		{
+			size_t rank = static_cast<size_t>(position - (*run).First);
+
+			for (T_RangeIterator it = firstRange; it != lastRange; ++it)
+			{
+				if (it == run) continue;
+
+				if (it - firstRange < run - firstRange)
+					rank += static_cast<size_t>(Upper_bound((*it).First, (*it).Second, *position, predicate) - (*it).First);
+				else
+					rank += static_cast<size_t>(Lower_bound((*it).First, (*it).Second, *position, predicate) - (*it).First);
+			}
+
+			return rank;
+		}
+	}
+
+	template<typename T_RangeIterator, typename T_IteratorOutput, typename T_Predicate>
+	inline T_IteratorOutput Merge_k(T_RangeIterator firstRange, T_RangeIterator lastRange, T_IteratorOutput result, T_Predicate predicate)
+	{
+		typedef Remove_cvref_t<decltype((*firstRange).First)> T_Iterator;
+
+		Detail::Loser_tree<T_Iterator, T_Predicate> tree(firstRange, lastRange, predicate);
+
+		while (!tree.Empty())
+		{
+			*result = *tree.Top();
+			++result;
+			tree.Pop();
+		}
+
+		return result;
+	}
+
+	template<typename T_RangeIterator, typename T_IteratorOutput>
+	inline T_IteratorOutput Merge_k(T_RangeIterator firstRange, T_RangeIterator lastRange, T_IteratorOutput result)
+	{
+		return Merge_k(firstRange, lastRange, result, [](const auto& left, const auto& right) { return left < right; });
+	}
+
+	//co-ranking: writes for every run the position where the first rank elements of the merge end
+	template<typename T_RangeIterator, typename T_IteratorOutput, typename T_Predicate>
+	inline T_IteratorOutput Merge_k_split(T_RangeIterator firstRange, T_RangeIterator lastRange, size_t rank, T_IteratorOutput splits, T_Predicate predicate)
+	{
+		for (T_RangeIterator run = firstRange; run != lastRange; ++run)
+		{
+			auto low = (*run).First;
+			auto high = (*run).Second;
+
+			while (low < high)
+			{
+				auto middle = low + (high - low) / 2;
+				size_t middleRank = Detail::mergeRank(firstRange, lastRange, run, middle, predicate);
+
+				if (middleRank == rank)
+				{
+					for (T_RangeIterator it = firstRange; it != lastRange; ++it)
+					{
+						if (it == run)
+							*splits = middle;
+						else if (it - firstRange < run - firstRange)
+							*splits = Upper_bound((*it).First, (*it).Second, *middle, predicate);
+						else
+							*splits = Lower_bound((*it).First, (*it).Second, *middle, predicate);
+
+						++splits;
+					}
+
+					return splits;
+				}
+
+				if (middleRank < rank)
+					low = middle + 1;
+				else
+					high = middle;
+			}
+		}
+
+		//rank is the total size
+		for (T_RangeIterator it = firstRange; it != lastRange; ++it)
+		{
+			*splits = (*it).Second;
+			++splits;
+		}
+
+		return splits;
+	}
+
+	template<typename T_RangeIterator, typename T_IteratorOutput>
+	inline T_IteratorOutput Merge_k_split(T_RangeIterator firstRange, T_RangeIterator lastRange, size_t rank, T_IteratorOutput splits)
+	{
+		return Merge_k_split(firstRange, lastRange, rank, splits, [](const auto& left, const auto& right) { return left < right; });
+	}
+
+	template<typename T_Iterator1, typename T_Iterator2>
+	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2)
+	{
+		while (first1 != last1 && *first1 == *first2)
+		{
+			++first1;
+			++first2;
+		}
+
+		return Pair<T_Iterator1, T_Iterator2>(first1, first2);
+	}
+
+	template<typename T_Iterator1, typename T_Iterator2, typename T_Predicate>
+	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Predicate predicate)
+	{
+		while (first1 != last1 && predicate(*first1, *first2))
+		{
+			++first1;
+			++first2;
+		}
+
+		return Pair<T_Iterator1, T_Iterator2>(first1, first2);
+	}
+
+	template<typename T_Iterator1, typename T_Iterator2>
+	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Iterator2 last2)
+	{
+		if ((last1 - first1) != (last2 - first2)) return Pair<T_Iterator1, T_Iterator2>(first1, first2);
+
+			while (first1 != last1 && *first1 == *first2)
+			{
+				++first1;
+				++first2;
+			}
+
+		return Pair<T_Iterator1, T_Iterator2>(first1, first2);
+	}
+
+	template<typename T_Iterator1, typename T_Iterator2, typename T_Predicate>
+	inline Pair<T_Iterator1, T_Iterator2> Mismatch(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Iterator2 last2, T_Predicate predicate)
+	{
+		if ((last1 - first1) != (last2 - first2)) return Pair<T_Iterator1, T_Iterator2>(first1, first2);
+
+		while (first1 != last1 && predicate(*first1, *first2))
+		{
+			++first1;
+			++first2;
+		}
 
 		return Pair<T_Iterator1, T_Iterator2>(first1, first2);
 	}
@@ -1252,7 +1924,7 @@ namespace DVTL {
 	{
 		while (first != last)
 		{
-			output = Move(*first);
+			*output = Move(*first);
 
 			++first;
 			++output;
@@ -1268,7 +1940,7 @@ namespace DVTL {
 		{
 			--last;
 			--output;
-			output = Move(*last);
+			*output = Move(*last);
 		}
 
 		return output;
@@ -1288,7 +1960,7 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator>
-	inline T_Iterator Nth_element(T_Iterator first, T_Iterator nth, T_Iterator last)
+	constexpr T_Iterator Nth_element(T_Iterator first, T_Iterator nth, T_Iterator last)
 	{
 		--last;
 		Iter_swap(nth, last);
@@ -1307,7 +1979,7 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator, typename T_Predicate>
-	inline T_Iterator Nth_element(T_Iterator first, T_Iterator nth, T_Iterator last, T_Predicate predicate)
+	constexpr T_Iterator Nth_element(T_Iterator first, T_Iterator nth, T_Iterator last, T_Predicate predicate)
 	{
 		--last;
 		Iter_swap(nth, last);
@@ -1372,23 +2044,22 @@ namespace DVTL {
 	template<typename T_Iterator, typename T_Predicate>
 	inline T_Iterator Partition(T_Iterator first, T_Iterator last, T_Predicate predicate)
 	{
-		if (first == last) return first;
-
-		--last;
-
-		while (first < last)
+		while (true)
 		{
-			while (predicate(*first))
+			while (first != last && predicate(*first))
 				++first;
 
-			while (!predicate(*last))
+			if (first == last) return first;
+
+			do
 				--last;
+			while (first != last && !predicate(*last));
 
-			if (last > first)
-				Iter_swap(first, last);
-		}
+			if (first == last) return first;
 
-		return first;
+			Iter_swap(first, last);
+			++first;
+		}
 	}
 
 	template<typename T_IteratorInput, typename T_IteratorOutput1, typename T_IteratorOutput2, typename T_Predicate>
@@ -1421,208 +2092,165 @@ namespace DVTL {
 		return first;
 	}
 
-	template<typename T_Iterator>
-	inline void Push_heap(T_Iterator first, T_Iterator last)
+	namespace Detail
 	{
-		if (first == last) return;
-		
-		--last;
-		size_t index = last - first;
-		size_t parent = (index - 1) / 2;
-		while (index > 0)
+		template<size_t D, typename T_Iterator, typename T_Value, typename T_Predicate>
+		inline void siftUpD(T_Iterator first, size_t hole, T_Value& value, T_Predicate& predicate)
 		{
-			T_Iterator it_index = first + index;
-			T_Iterator it_parent = first + parent;
-			if (*it_index > *it_parent) {
-				Iter_swap(it_index, it_parent);
-				index = parent;
-				parent = (index - 1) / 2;
+			while (hole > 0)
+			{
+				size_t parent = (hole - 1) / D;
+				if (!predicate(value, first[parent])) break;
+
+				first[hole] = Move(first[parent]);
+				hole = parent;
 			}
-			else
-				break;
-		}
-	}
 
-	template<typename T_Iterator, typename T_Predicate>
-	inline void Push_heap(T_Iterator first, T_Iterator last, T_Predicate predicate)
-	{
-		if (first == last) return;
+			first[hole] = Move(value);
+		}
 
-		--last;
-		size_t index = last - first;
-		size_t parent = (index - 1) / 2;
-		while (index>0)
+		//moves the hole down to the leaf level through the best children, then places value
+		template<size_t D, typename T_Iterator, typename T_Value, typename T_Predicate>
+		inline void siftDownD(T_Iterator first, size_t size, size_t hole, T_Value& value, T_Predicate& predicate)
 		{
-			T_Iterator it_index = first + index;
-			T_Iterator it_parent = first + parent;
-			if (predicate(*it_index, *it_parent)) {
-				Iter_swap(it_index, it_parent);
-				index = parent;
-				parent = (index - 1) / 2;
+			while (true)
+			{
+				size_t child = hole * D + 1;
+				if (child >= size) break;
+
+				size_t best = child;
+				size_t end = Min(child + D, size);
+				for (++child; child < end; ++child)
+					if (predicate(first[child], first[best]))
+						best = child;
+
+				if (!predicate(first[best], value)) break;
+
+				first[hole] = Move(first[best]);
+				hole = best;
 			}
-			else
-				break;
+
+			first[hole] = Move(value);
 		}
 	}
 
-	template<typename T_Iterator>
-	inline void Pop_heap(T_Iterator first, T_Iterator last)
+	//D-ary heaps keep the children of a node in one cache line for D of 4 or 8 and halve the depth;
+	//as with Push_heap, predicate(a, b) means a belongs above b and the default keeps the greatest on top
+	template<size_t D, typename T_Iterator, typename T_Predicate>
+	inline void Push_heap_d(T_Iterator first, T_Iterator last, T_Predicate predicate)
 	{
+		static_assert(D >= 2, "heap arity must be at least 2");
 		if (first == last) return;
-		Iter_swap(first, --last);
-		
-		size_t index = 0;
-		size_t left = 1;
-		size_t right = 2;
-		size_t Size = last - first;
-		while (left < Size) {
-			T_Iterator it_index = first + index;
-			T_Iterator it_left = first + left;
-			T_Iterator it_right = first + right;
-
-			if (right == Size) {
-				if(*it_left > *it_index)
-					Iter_swap(it_index, it_left);
 
-				break;
-			}
+		size_t hole = last - first - 1;
+		auto value = Move(first[hole]);
+		Detail::siftUpD<D>(first, hole, value, predicate);
+	}
 
-			if (*it_index > *it_left)
-			{
-				if (*it_index > *it_right)
-					break;
-				else
-				{
-					Iter_swap(it_index, it_right);
-					index = right;
-				}
-			}
-			else
-			{
-				if (*it_index > *it_right)
-				{
-					Iter_swap(it_index, it_left);
-					index = left;
-				}
-				else
-				{
-					if (*it_right > *it_left)
-					{
-						Iter_swap(it_index, it_right);
-						index = right;
-					}
-					else
-					{
-						Iter_swap(it_index, it_left);
-						index = left;
-					}
-				}
-			}
+	template<size_t D, typename T_Iterator>
+	inline void Push_heap_d(T_Iterator first, T_Iterator last)
+	{
+		Push_heap_d<D>(first, last, [](const auto& left, const auto& right) { return left > right; });
+	}
+
+	template<size_t D, typename T_Iterator, typename T_Predicate>
+	inline void Pop_heap_d(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		static_assert(D >= 2, "heap arity must be at least 2");
+		size_t size = last - first;
+		if (size < 2) return;
+
+		--size;
+		auto value = Move(first[size]);
+		first[size] = Move(*first);
+		Detail::siftDownD<D>(first, size, 0, value, predicate);
+	}
+
+	template<size_t D, typename T_Iterator>
+	inline void Pop_heap_d(T_Iterator first, T_Iterator last)
+	{
+		Pop_heap_d<D>(first, last, [](const auto& left, const auto& right) { return left > right; });
+	}
 
-			left = index * 2 - 1;
-			right = index * 2;
+	//bottom-up construction, linear in the number of elements
+	template<size_t D, typename T_Iterator, typename T_Predicate>
+	inline void Make_heap_d(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		static_assert(D >= 2, "heap arity must be at least 2");
+		size_t size = last - first;
+		if (size < 2) return;
+
+		for (size_t parent = (size - 2) / D + 1; parent-- > 0;)
+		{
+			auto value = Move(first[parent]);
+			Detail::siftDownD<D>(first, size, parent, value, predicate);
 		}
 	}
 
-	template<typename T_Iterator, typename T_Predicate>
-	inline void Pop_heap(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	template<size_t D, typename T_Iterator>
+	inline void Make_heap_d(T_Iterator first, T_Iterator last)
 	{
-		if (first == last) return;
-		Iter_swap(first, --last);
+		Make_heap_d<D>(first, last, [](const auto& left, const auto& right) { return left > right; });
+	}
 
-		size_t index = 0;
-		size_t left = 1;
-		size_t right = 2;
-		size_t Size = last - first;
-		while (left < Size) {
-			T_Iterator it_index = first + index;
-			T_Iterator it_left = first + left;
-			T_Iterator it_right = first + right;
+	template<size_t D, typename T_Iterator, typename T_Predicate>
+	inline bool Is_heap_d(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		size_t size = last - first;
 
-			if (right == Size) {
-				if (predicate(*it_left, *it_index))
-					Iter_swap(it_index, it_left);
+		for (size_t i = 1; i < size; ++i)
+			if (predicate(first[i], first[(i - 1) / D]))
+				return false;
 
-				break;
-			}
+		return true;
+	}
 
-			if (predicate(*it_index, *it_left))
-			{
-				if (predicate(*it_index, *it_right))
-					break;
-				else
-				{
-					Iter_swap(it_index, it_right);
-					index = right;
-				}
-			}
-			else
-			{
-				if (predicate(*it_index, *it_right))
-				{
-					Iter_swap(it_index, it_left);
-					index = left;
-				}
-				else
-				{
-					if (predicate(*it_right, *it_left))
-					{
-						Iter_swap(it_index, it_right);
-						index = right;
-					}
-					else
-					{
-						Iter_swap(it_index, it_left);
-						index = left;
-					}
-				}
-			}
+	template<size_t D, typename T_Iterator>
+	inline bool Is_heap_d(T_Iterator first, T_Iterator last)
+	{
+		return Is_heap_d<D>(first, last, [](const auto& left, const auto& right) { return left > right; });
+	}
 
-			left = index * 2 - 1;
-			right = index * 2;
-		}
+	template<typename T_Iterator>
+	inline void Push_heap(T_Iterator first, T_Iterator last)
+	{
+		Push_heap_d<2>(first, last);
+	}
+
+	template<typename T_Iterator, typename T_Predicate>
+	inline void Push_heap(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		Push_heap_d<2>(first, last, predicate);
+	}
+
+	template<typename T_Iterator>
+	inline void Pop_heap(T_Iterator first, T_Iterator last)
+	{
+		Pop_heap_d<2>(first, last);
+	}
+
+	template<typename T_Iterator, typename T_Predicate>
+	inline void Pop_heap(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		Pop_heap_d<2>(first, last, predicate);
 	}
 
 	template<typename T_Iterator>
 	inline void Make_heap(T_Iterator first, T_Iterator last)
 	{
-		T_Iterator it=first+1;
-		while (it != last) 
-		{
-			Push_heap(first, it);
-			++it;
-		}
+		Make_heap_d<2>(first, last);
 	}
 
 	template<typename T_Iterator, typename T_Predicate>
 	inline void Make_heap(T_Iterator first, T_Iterator last, T_Predicate predicate)
 	{
-		T_Iterator it = first + 1;
-		while (it != last)
-		{
-			Push_heap(first, it, predicate);
-			++it;
-		}
+		Make_heap_d<2>(first, last, predicate);
 	}
 
 	template<typename T_Iterator, typename T_Type>
 	inline T_Iterator Remove(T_Iterator first, T_Iterator last, const T_Type& value) 
 	{
-		T_Iterator it = first;
-		
-		while (it != last)
-		{
-			if (*it == value)
-				++it;
-			else
-			{
-				*first = *it;
-				++first;
-				++it;
-			}
-		}
-
-		return first;
+		return Detail::remove(first, last, value, Bool_constant<Detail::Is_simd_compactable<T_Iterator>::value && Is_same_v<T_Type, Detail::Iterator_value_t<T_Iterator>>>());
 	}
 
 	template<typename T_IteratorInput, typename T_IteratorOutput, typename T_Type>
@@ -1658,21 +2286,7 @@ namespace DVTL {
 	template<typename T_Iterator, typename T_Predicate>
 	inline T_Iterator Remove_if(T_Iterator first, T_Iterator last, T_Predicate predicate)
 	{
-		T_Iterator it = first;
-
-		while (it != last)
-		{
-			if (predicate(*it))
-				++it;
-			else
-			{
-				*first = *it;
-				++first;
-				++it;
-			}
-		}
-
-		return first;
+		return Detail::removeIf(first, last, predicate, Detail::Is_branchless_compactable<T_Iterator>());
 	}
 
 	template<typename T_Iterator, typename T_Type>
@@ -1734,7 +2348,7 @@ namespace DVTL {
 	}
 
 	template<typename T_Iterator>
-	inline void Reverse(T_Iterator first, T_Iterator last)
+	constexpr void Reverse(T_Iterator first, T_Iterator last)
 	{
 		if (first == last) return;
 
@@ -2228,11 +2842,11 @@ namespace DVTL {
 	}
 
 	template<typename T_Type>
-	inline void Swap(T_Type& left, T_Type& right)
+	constexpr void Swap(T_Type& left, T_Type& right)
 	{
-		T_Type temp = left;
-		left = right;
-		right = temp;
+		T_Type temp = Move(left);
+		left = Move(right);
+		right = Move(temp);
 	}
 
 	template<typename T_Type, size_t N>
@@ -2240,9 +2854,9 @@ namespace DVTL {
 	{
 		for (size_t i = 0; i < N; ++i)
 		{
-			T_Type temp = left[i];
-			left[i] = right[i];
-			right[i] = temp;
+			T_Type temp = Move(left[i]);
+			left[i] = Move(right[i]);
+			right[i] = Move(temp);
 		}
 	}
 
@@ -2250,9 +2864,7 @@ namespace DVTL {
 	inline void Swap_ranges(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2)
 	{
 		while (first1 != last1) {
-			T_Iterator2 temp = first2;
-			*first2 = *first1;
-			*first1 = *temp;
+			Iter_swap(first1, first2);
 
 			++first1;
 			++first2;
@@ -2289,43 +2901,164 @@ namespace DVTL {
 	template<typename T_Iterator>
 	inline T_Iterator Unique(T_Iterator first, T_Iterator last)
 	{
-		if (first == last) {
-			return last;
-		}
+		if (first == last) {
+			return last;
+		}
+
+		return Detail::unique(first, last, Detail::Is_simd_compactable<T_Iterator>());
+	}
+
+	template<typename T_Iterator, typename T_Predicate>
+	inline T_Iterator Unique(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		if (first == last) {
+			return last;
+		}
+
+		return Detail::unique(first, last, predicate, Detail::Is_branchless_compactable<T_Iterator>());
+	}
+
+	namespace Detail
+	{
+		//open addressing set of indices into storage owned by the caller, linear probing at load factor 1/2;
+		//the full hash is kept per slot so probing rarely calls the equality
+		class Hash_index
+		{
+		public:
+			static constexpr size_t npos = static_cast<size_t>(-1);
+
+			Hash_index() :m_slots(16, Slot{ 0, npos }), m_count(0) {}
+
+			//returns the index already stored for an equal key, or stores index and returns npos
+			template<typename T_Equal>
+			size_t Insert(size_t hash, size_t index, T_Equal&& equalAt)
+			{
+				if ((m_count + 1) * 2 > m_slots.Size()) grow();
+
+				size_t mask = m_slots.Size() - 1;
+				for (size_t slot = position(hash); ; slot = (slot + 1) & mask)
+				{
+					Slot& current = m_slots[slot];
+
+					if (current.index == npos)
+					{
+						current = Slot{ hash, index };
+						++m_count;
+						return npos;
+					}
+
+					if (current.hash == hash && equalAt(current.index)) return current.index;
+				}
+			}
+		private:
+			struct Slot
+			{
+				size_t hash;
+				size_t index;
+			};
+
+			Vector<Slot> m_slots;
+			size_t m_count;
+
+			//Fibonacci hashing spreads weak hashes over the power of two table
+			size_t position(size_t hash) const { return static_cast<size_t>((static_cast<unsigned long long>(hash) * 0x9E3779B97F4A7C15ull) >> 32) & (m_slots.Size() - 1); }
+
+			void grow()
+			{
+				Vector<Slot> slots(m_slots.Size() * 2, Slot{ 0, npos });
+				slots.Swap(m_slots);
+
+				size_t mask = m_slots.Size() - 1;
+				for (size_t i = 0; i < slots.Size(); ++i)
+				{
+					if (slots[i].index == npos) continue;
+
+					size_t slot = position(slots[i].hash);
+					while (m_slots[slot].index != npos)
+						slot = (slot + 1) & mask;
+
+					m_slots[slot] = slots[i];
+				}
+			}
+		};
+	}
+
+	//order-preserving removal of every repeated element in one pass without sorting,
+	//the first occurrence of each value is kept; returns the new end like Unique
+	template<typename T_Iterator, typename T_Hash, typename T_Equal>
+	inline T_Iterator Unique_unsorted(T_Iterator first, T_Iterator last, T_Hash hash, T_Equal equal)
+	{
+		Detail::Hash_index index;
+		T_Iterator result = first;
+		size_t kept = 0;
+
+		for (T_Iterator it = first; it != last; ++it)
+		{
+			auto& value = *it;
+			if (index.Insert(hash(value), kept, [&](size_t i) { return equal(first[i], value); }) != Detail::Hash_index::npos) continue;
+
+			if (result != it)
+				*result = Move(value);
+
+			++result;
+			++kept;
+		}
+
+		return result;
+	}
+
+	template<typename T_Iterator>
+	inline T_Iterator Unique_unsorted(T_Iterator first, T_Iterator last)
+	{
+		typedef Detail::Iterator_value_t<T_Iterator> Value;
+		return Unique_unsorted(first, last, Hash<Value>(), Equal_to<Value>());
+	}
+
+	//one-pass group by: aggregate(accumulator, element) folds every element into the accumulator of its key,
+	//each accumulator starts as a copy of initial; groups are returned in order of first appearance
+	template<typename T_Iterator, typename T_Key, typename T_Accumulator, typename T_Aggregate, typename T_Hash, typename T_Equal>
+	inline auto Group_by(T_Iterator first, T_Iterator last, T_Key key, const T_Accumulator& initial, T_Aggregate aggregate, T_Hash hash, T_Equal equal)
+		-> Vector<Pair<Remove_cvref_t<decltype(key(*first))>, T_Accumulator>>
+	{
+		Vector<Pair<Remove_cvref_t<decltype(key(*first))>, T_Accumulator>> groups;
+		Detail::Hash_index index;
 
-		T_Iterator result = first;
-		++first;
+		for (; first != last; ++first)
+		{
+			auto&& groupKey = key(*first);
+			size_t group = index.Insert(hash(groupKey), groups.Size(), [&](size_t i) { return equal(groups[i].First, groupKey); });
 
-		while (first != last) {
-			if (*result != *first) {
-				++result;
-				*result = *first;
+			if (group == Detail::Hash_index::npos)
+			{
+				group = groups.Size();
+				groups.Emplace_back(groupKey, initial);
 			}
-			++first;
+
+			aggregate(groups[group].Second, *first);
 		}
 
-		return ++result;
+		return groups;
 	}
 
-	template<typename T_Iterator, typename T_Predicate>
-	inline T_Iterator Unique(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	template<typename T_Iterator, typename T_Key, typename T_Accumulator, typename T_Aggregate>
+	inline auto Group_by(T_Iterator first, T_Iterator last, T_Key key, const T_Accumulator& initial, T_Aggregate aggregate)
+		-> Vector<Pair<Remove_cvref_t<decltype(key(*first))>, T_Accumulator>>
 	{
-		if (first == last) {
-			return last;
-		}
-
-		T_Iterator result = first;
-		++first;
+		typedef Remove_cvref_t<decltype(key(*first))> Key;
+		return Group_by(first, last, key, initial, aggregate, Hash<Key>(), Equal_to<Key>());
+	}
 
-		while (first != last) {
-			if (predicate(*result, *first)) {
-				++result;
-				*result = *first;
-			}
-			++first;
-		}
+	//occurrences of every key in order of first appearance
+	template<typename T_Iterator, typename T_Key>
+	inline auto Count_by_key(T_Iterator first, T_Iterator last, T_Key key) -> Vector<Pair<Remove_cvref_t<decltype(key(*first))>, size_t>>
+	{
+		return Group_by(first, last, key, size_t(0), [](size_t& count, const auto&) { ++count; });
+	}
 
-		return ++result;
+	template<typename T_Iterator>
+	inline auto Count_by_key(T_Iterator first, T_Iterator last) -> Vector<Pair<Detail::Iterator_value_t<T_Iterator>, size_t>>
+	{
+		return Count_by_key(first, last, [](const auto& element) -> const auto& { return element; });
 	}
 
 	template<typename T_Iterator, typename T_Iterator2>
@@ -2598,36 +3331,372 @@ namespace DVTL {
 		return first2;
 	}
 
-	template<typename T_Iterator>
-	inline void Sort(T_Iterator first, T_Iterator last)
-	{
-		if (last - first < 6)
+	namespace Detail
+	{
+		struct Sorting_network
+		{
+			size_t count;
+			unsigned char left[64];
+			unsigned char right[64];
+		};
+
+		//best known networks for 9 to 16 elements, one row per parallel layer; the comparator counts
+		//25, 29, 35, 39, 45, 51, 56 and 60 are proven optimal up to 12 and the smallest known above,
+		//15 is the 16 network without its last wire
+		constexpr unsigned char sortingNetwork9[25][2] = {
+			{ 0, 3 }, { 1, 7 }, { 2, 5 }, { 4, 8 },
+			{ 0, 7 }, { 2, 4 }, { 3, 8 }, { 5, 6 },
+			{ 0, 2 }, { 1, 3 }, { 4, 5 }, { 7, 8 },
+			{ 1, 4 }, { 3, 6 }, { 5, 7 },
+			{ 0, 1 }, { 2, 4 }, { 3, 5 }, { 6, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 },
+			{ 1, 2 }, { 3, 4 }, { 5, 6 }
+		};
+
+		constexpr unsigned char sortingNetwork10[29][2] = {
+			{ 0, 8 }, { 1, 9 }, { 2, 7 }, { 3, 5 }, { 4, 6 },
+			{ 0, 2 }, { 1, 4 }, { 5, 8 }, { 7, 9 },
+			{ 0, 3 }, { 2, 4 }, { 5, 7 }, { 6, 9 },
+			{ 0, 1 }, { 3, 6 }, { 8, 9 },
+			{ 1, 5 }, { 2, 3 }, { 4, 8 }, { 6, 7 },
+			{ 1, 2 }, { 3, 5 }, { 4, 6 }, { 7, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 },
+			{ 3, 4 }, { 5, 6 }
+		};
+
+		constexpr unsigned char sortingNetwork11[35][2] = {
+			{ 0, 9 }, { 1, 6 }, { 2, 4 }, { 3, 7 }, { 5, 8 },
+			{ 0, 1 }, { 3, 5 }, { 4, 10 }, { 6, 9 }, { 7, 8 },
+			{ 1, 3 }, { 2, 5 }, { 4, 7 }, { 8, 10 },
+			{ 0, 4 }, { 1, 2 }, { 3, 7 }, { 5, 9 }, { 6, 8 },
+			{ 0, 1 }, { 2, 6 }, { 4, 5 }, { 7, 8 }, { 9, 10 },
+			{ 2, 4 }, { 3, 6 }, { 5, 7 }, { 8, 9 },
+			{ 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 }
+		};
+
+		constexpr unsigned char sortingNetwork12[39][2] = {
+			{ 0, 8 }, { 1, 7 }, { 2, 6 }, { 3, 11 }, { 4, 10 }, { 5, 9 },
+			{ 0, 1 }, { 2, 5 }, { 3, 4 }, { 6, 9 }, { 7, 8 }, { 10, 11 },
+			{ 0, 2 }, { 1, 6 }, { 5, 10 }, { 9, 11 },
+			{ 0, 3 }, { 1, 2 }, { 4, 6 }, { 5, 7 }, { 8, 11 }, { 9, 10 },
+			{ 1, 4 }, { 3, 5 }, { 6, 8 }, { 7, 10 },
+			{ 1, 3 }, { 2, 5 }, { 6, 9 }, { 8, 10 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 },
+			{ 4, 6 }, { 5, 7 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 }
+		};
+
+		constexpr unsigned char sortingNetwork13[45][2] = {
+			{ 0, 12 }, { 1, 10 }, { 2, 9 }, { 3, 7 }, { 5, 11 }, { 6, 8 },
+			{ 1, 6 }, { 2, 3 }, { 4, 11 }, { 7, 9 }, { 8, 10 },
+			{ 0, 4 }, { 1, 2 }, { 3, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+			{ 4, 6 }, { 5, 9 }, { 8, 11 }, { 10, 12 },
+			{ 0, 5 }, { 3, 8 }, { 4, 7 }, { 6, 11 }, { 9, 10 },
+			{ 0, 1 }, { 2, 5 }, { 6, 9 }, { 7, 8 }, { 10, 11 },
+			{ 1, 3 }, { 2, 4 }, { 5, 6 }, { 9, 10 },
+			{ 1, 2 }, { 3, 4 }, { 5, 7 }, { 6, 8 },
+			{ 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 },
+			{ 3, 4 }, { 5, 6 }
+		};
+
+		constexpr unsigned char sortingNetwork14[51][2] = {
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 }, { 10, 11 }, { 12, 13 },
+			{ 0, 2 }, { 1, 3 }, { 4, 8 }, { 5, 9 }, { 10, 12 }, { 11, 13 },
+			{ 0, 4 }, { 1, 2 }, { 3, 7 }, { 5, 8 }, { 6, 10 }, { 9, 13 }, { 11, 12 },
+			{ 0, 6 }, { 1, 5 }, { 3, 9 }, { 4, 10 }, { 7, 13 }, { 8, 12 },
+			{ 2, 10 }, { 3, 11 }, { 4, 6 }, { 7, 9 },
+			{ 1, 3 }, { 2, 8 }, { 5, 11 }, { 6, 7 }, { 10, 12 },
+			{ 1, 4 }, { 2, 6 }, { 3, 5 }, { 7, 11 }, { 8, 10 }, { 9, 12 },
+			{ 2, 4 }, { 3, 6 }, { 5, 8 }, { 7, 10 }, { 9, 11 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 },
+			{ 6, 7 }
+		};
+
+		constexpr unsigned char sortingNetwork15[56][2] = {
+			{ 0, 13 }, { 1, 12 }, { 3, 14 }, { 4, 8 }, { 5, 6 }, { 7, 11 }, { 9, 10 },
+			{ 0, 5 }, { 1, 7 }, { 2, 9 }, { 3, 4 }, { 6, 13 }, { 8, 14 }, { 11, 12 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 8 }, { 7, 9 }, { 10, 11 }, { 12, 13 },
+			{ 0, 2 }, { 1, 3 }, { 4, 10 }, { 5, 11 }, { 6, 7 }, { 8, 9 }, { 12, 14 },
+			{ 1, 2 }, { 3, 12 }, { 4, 6 }, { 5, 7 }, { 8, 10 }, { 9, 11 }, { 13, 14 },
+			{ 1, 4 }, { 2, 6 }, { 5, 8 }, { 7, 10 }, { 9, 13 }, { 11, 14 },
+			{ 2, 4 }, { 3, 6 }, { 9, 12 }, { 11, 13 },
+			{ 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+			{ 6, 7 }, { 8, 9 }
+		};
+
+		constexpr unsigned char sortingNetwork16[60][2] = {
+			{ 0, 13 }, { 1, 12 }, { 2, 15 }, { 3, 14 }, { 4, 8 }, { 5, 6 }, { 7, 11 }, { 9, 10 },
+			{ 0, 5 }, { 1, 7 }, { 2, 9 }, { 3, 4 }, { 6, 13 }, { 8, 14 }, { 10, 15 }, { 11, 12 },
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 8 }, { 7, 9 }, { 10, 11 }, { 12, 13 }, { 14, 15 },
+			{ 0, 2 }, { 1, 3 }, { 4, 10 }, { 5, 11 }, { 6, 7 }, { 8, 9 }, { 12, 14 }, { 13, 15 },
+			{ 1, 2 }, { 3, 12 }, { 4, 6 }, { 5, 7 }, { 8, 10 }, { 9, 11 }, { 13, 14 },
+			{ 1, 4 }, { 2, 6 }, { 5, 8 }, { 7, 10 }, { 9, 13 }, { 11, 14 },
+			{ 2, 4 }, { 3, 6 }, { 9, 12 }, { 11, 13 },
+			{ 3, 5 }, { 6, 8 }, { 7, 9 }, { 10, 12 },
+			{ 3, 4 }, { 5, 6 }, { 7, 8 }, { 9, 10 }, { 11, 12 },
+			{ 6, 7 }, { 8, 9 }
+		};
+
+		template<size_t Count>
+		constexpr Sorting_network copySortingNetwork(const unsigned char (&comparators)[Count][2])
+		{
+			Sorting_network network{ Count, {}, {} };
+
+			for (size_t i = 0; i < Count; ++i)
+			{
+				network.left[i] = comparators[i][0];
+				network.right[i] = comparators[i][1];
+			}
+
+			return network;
+		}
+
+		//Batcher's odd-even merge network is optimal up to 8 elements (19 comparators for 8),
+		//larger sizes take the tables above
+		constexpr Sorting_network makeSortingNetwork(size_t size)
 		{
-			Partial_sort(first, last, last);
-			return;
+			switch (size)
+			{
+			case 9:		return copySortingNetwork(sortingNetwork9);
+			case 10:	return copySortingNetwork(sortingNetwork10);
+			case 11:	return copySortingNetwork(sortingNetwork11);
+			case 12:	return copySortingNetwork(sortingNetwork12);
+			case 13:	return copySortingNetwork(sortingNetwork13);
+			case 14:	return copySortingNetwork(sortingNetwork14);
+			case 15:	return copySortingNetwork(sortingNetwork15);
+			case 16:	return copySortingNetwork(sortingNetwork16);
+			default:	break;
+			}
+
+			Sorting_network network{ 0, {}, {} };
+
+			size_t power = 1;
+			while (power < size)
+				power <<= 1;
+
+			for (size_t p = 1; p < power; p <<= 1)
+				for (size_t k = p; k >= 1; k >>= 1)
+					for (size_t j = k % p; j + k < power; j += 2 * k)
+						for (size_t i = 0; i < k && i + j + k < size; ++i)
+						{
+							if ((i + j) / (2 * p) != (i + j + k) / (2 * p)) continue;
+
+							network.left[network.count] = static_cast<unsigned char>(i + j);
+							network.right[network.count] = static_cast<unsigned char>(i + j + k);
+							++network.count;
+						}
+
+			return network;
+		}
+
+		template<size_t N>
+		struct Sorting_network_of
+		{
+			static constexpr Sorting_network value = makeSortingNetwork(N);
+		};
+
+		template<size_t N> constexpr Sorting_network Sorting_network_of<N>::value;
+
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr void compareExchange(T_Iterator left, T_Iterator right, T_Predicate& predicate, True_type)
+		{
+			auto leftValue = *left;
+			auto rightValue = *right;
+			bool swap = predicate(rightValue, leftValue);
+
+			*left = swap ? rightValue : leftValue;
+			*right = swap ? leftValue : rightValue;
+		}
+
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr void compareExchange(T_Iterator left, T_Iterator right, T_Predicate& predicate, False_type)
+		{
+			if (predicate(*right, *left))
+				Iter_swap(left, right);
 		}
 
-		T_Iterator nth = first + (last - first) / 2;
-		nth = Nth_element(first, nth, last);
+		template<size_t N, size_t I, size_t Count = Sorting_network_of<N>::value.count>
+		struct Sorting_network_step
+		{
+			template<typename T_Iterator, typename T_Predicate>
+			static constexpr void Apply(T_Iterator first, T_Predicate& predicate)
+			{
+				constexpr size_t left = Sorting_network_of<N>::value.left[I];
+				constexpr size_t right = Sorting_network_of<N>::value.right[I];
+
+				compareExchange(first + left, first + right, predicate, Bool_constant<Is_arithmetic_v<Iterator_value_t<T_Iterator>>>());
+				Sorting_network_step<N, I + 1, Count>::Apply(first, predicate);
+			}
+		};
 
-		Sort(first, nth);
-		Sort(nth + 1, last);
+		template<size_t N, size_t Count>
+		struct Sorting_network_step<N, Count, Count>
+		{
+			template<typename T_Iterator, typename T_Predicate>
+			static constexpr void Apply(T_Iterator, T_Predicate&) {}
+		};
 	}
 
-	template<typename T_Iterator, typename T_Predicate>
-	inline void Sort(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	template<size_t N, typename T_Iterator, typename T_Predicate>
+	constexpr void Sort_small(T_Iterator first, T_Predicate predicate)
+	{
+		static_assert(N <= 16, "sorting networks are available for at most 16 elements");
+		Detail::Sorting_network_step<N, 0>::Apply(first, predicate);
+	}
+
+	template<size_t N, typename T_Iterator>
+	constexpr void Sort_small(T_Iterator first)
+	{
+		Sort_small<N>(first, Less_than<Detail::Iterator_value_t<T_Iterator>>());
+	}
+
+	namespace Detail
 	{
-		if (last - first < 6)
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr void sortSmall(T_Iterator first, size_t size, T_Predicate& predicate)
 		{
-			Partial_sort(first, last, last, predicate);
-			return;
+			switch (size)
+			{
+			case 2:		Sort_small<2>(first, predicate); break;
+			case 3:		Sort_small<3>(first, predicate); break;
+			case 4:		Sort_small<4>(first, predicate); break;
+			case 5:		Sort_small<5>(first, predicate); break;
+			case 6:		Sort_small<6>(first, predicate); break;
+			case 7:		Sort_small<7>(first, predicate); break;
+			case 8:		Sort_small<8>(first, predicate); break;
+			case 9:		Sort_small<9>(first, predicate); break;
+			case 10:	Sort_small<10>(first, predicate); break;
+			case 11:	Sort_small<11>(first, predicate); break;
+			case 12:	Sort_small<12>(first, predicate); break;
+			case 13:	Sort_small<13>(first, predicate); break;
+			case 14:	Sort_small<14>(first, predicate); break;
+			case 15:	Sort_small<15>(first, predicate); break;
+			case 16:	Sort_small<16>(first, predicate); break;
+			default:	break;
+			}
+		}
+
+		//sift-down by swaps instead of a moved-out hole, so the heap sort stays usable in constant expressions
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr void siftDownSwap(T_Iterator first, size_t root, size_t size, T_Predicate& predicate)
+		{
+			while (true)
+			{
+				size_t child = root * 2 + 1;
+				if (child >= size) break;
+				if (child + 1 < size && predicate(first[child], first[child + 1])) ++child;
+				if (!predicate(first[root], first[child])) break;
+
+				Iter_swap(first + root, first + child);
+				root = child;
+			}
+		}
+
+		//O(n log n) for every input, takes over the ranges introsort keeps splitting badly
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr void heapSort(T_Iterator first, size_t size, T_Predicate& predicate)
+		{
+			for (size_t root = size / 2; root-- > 0;)
+				siftDownSwap(first, root, size, predicate);
+
+			for (size_t end = size; end > 1;)
+			{
+				--end;
+				Iter_swap(first, first + end);
+				siftDownSwap(first, 0, end, predicate);
+			}
+		}
+
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr void moveMedianToFirst(T_Iterator result, T_Iterator a, T_Iterator b, T_Iterator c, T_Predicate& predicate)
+		{
+			if (predicate(*a, *b)) {
+				if (predicate(*b, *c))		Iter_swap(result, b);
+				else if (predicate(*a, *c))	Iter_swap(result, c);
+				else						Iter_swap(result, a);
+			}
+			else if (predicate(*a, *c))		Iter_swap(result, a);
+			else if (predicate(*b, *c))		Iter_swap(result, c);
+			else							Iter_swap(result, b);
+		}
+
+		//Hoare partition around the median of three kept at first: both scans stop on keys equal to the pivot,
+		//so runs of equal keys are split in the middle instead of all landing on one side;
+		//the median of three leaves a stopper on each side, so the scans need no bounds checks
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr T_Iterator partitionPivot(T_Iterator first, T_Iterator last, T_Predicate& predicate)
+		{
+			moveMedianToFirst(first, first + 1, first + (last - first) / 2, last - 1, predicate);
+
+			T_Iterator left = first + 1;
+			T_Iterator right = last;
+
+			while (true)
+			{
+				while (predicate(*left, *first)) ++left;
+				--right;
+				while (predicate(*first, *right)) --right;
+				if (!(left < right)) return left;
+
+				Iter_swap(left, right);
+				++left;
+			}
+		}
+
+		//the smaller side is sorted recursively and the larger one in the loop, so at most log2 n frames are live;
+		//budget counts the partitions left before a heap sort takes over
+		template<typename T_Iterator, typename T_Predicate>
+		constexpr void introsort(T_Iterator first, T_Iterator last, size_t budget, T_Predicate& predicate)
+		{
+			while (last - first > 16)
+			{
+				if (budget == 0)
+				{
+					heapSort(first, static_cast<size_t>(last - first), predicate);
+					return;
+				}
+				--budget;
+
+				T_Iterator cut = partitionPivot(first, last, predicate);
+
+				if (cut - first < last - cut) {
+					introsort(first, cut, budget, predicate);
+					first = cut;
+				}
+				else {
+					introsort(cut, last, budget, predicate);
+					last = cut;
+				}
+			}
+
+			sortSmall(first, static_cast<size_t>(last - first), predicate);
+		}
+
+		//twice the floor of log2 size, the introsort limit
+		constexpr size_t introsortBudget(size_t size)
+		{
+			size_t budget = 0;
+			for (; size > 1; size >>= 1)
+				budget += 2;
+			return budget;
 		}
+	}
 
-		T_Iterator nth = first + (last - first) / 2;
-		nth = Nth_element(first, nth, last, predicate);
+	//introsort: quicksort on the median of three, heap sort past 2 log2 n levels and sorting networks
+	//for the last 16 elements of a range; O(n log n) in the worst case, also with many equal keys, and not stable
+	template<typename T_Iterator>
+	constexpr void Sort(T_Iterator first, T_Iterator last)
+	{
+		Less_than<Detail::Iterator_value_t<T_Iterator>> predicate;
+		Detail::introsort(first, last, Detail::introsortBudget(static_cast<size_t>(last - first)), predicate);
+	}
 
-		Sort(first, nth, predicate);
-		Sort(nth + 1, last, predicate);
+	template<typename T_Iterator, typename T_Predicate>
+	constexpr void Sort(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		Detail::introsort(first, last, Detail::introsortBudget(static_cast<size_t>(last - first)), predicate);
 	}
 
 	template<typename T_Iterator>
@@ -2659,6 +3728,342 @@ namespace DVTL {
 			Inplace_merge(first, middle, last, predicate);
 		}
 	}
+
+	//indices of the elements in sorted order; equal elements keep their order, which also keeps
+	//key columns with few distinct values from handing the sort long runs of equivalent indices
+	template<typename T_Iterator, typename T_Predicate>
+	inline Vector<size_t> Sort_indices(T_Iterator first, T_Iterator last, T_Predicate predicate)
+	{
+		size_t size = last - first;
+		Vector<size_t> indices;
+		indices.Reserve(size);
+
+		for (size_t i = 0; i < size; ++i)
+			indices.Push_back(i);
+
+		Sort(indices.Begin(), indices.End(), [&first, &predicate](size_t left, size_t right) {
+			return predicate(first[left], first[right]) || (!predicate(first[right], first[left]) && left < right); });
+
+		return indices;
+	}
+
+	template<typename T_Iterator>
+	inline Vector<size_t> Sort_indices(T_Iterator first, T_Iterator last)
+	{
+		return Sort_indices(first, last, [](const auto& left, const auto& right) { return left < right; });
+	}
+
+	//element i becomes the element that was at permutation[i], every element is moved once by following cycles,
+	//visited indices are marked by complementing them and the permutation is restored on return
+	template<typename T_Iterator, typename T_IteratorIndex>
+	inline void Apply_permutation(T_Iterator first, T_Iterator last, T_IteratorIndex permutation)
+	{
+		size_t size = last - first;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (permutation[i] >= size) continue;
+
+			size_t current = i;
+			size_t source = permutation[i];
+
+			if (source != i)
+			{
+				auto temp = Move(first[i]);
+
+				while (source != i)
+				{
+					first[current] = Move(first[source]);
+					permutation[current] = ~source;
+					current = source;
+					source = permutation[current];
+				}
+
+				first[current] = Move(temp);
+			}
+
+			permutation[current] = ~source;
+		}
+
+		for (size_t i = 0; i < size; ++i)
+			permutation[i] = ~permutation[i];
+	}
+
+	//stable, the values of equal keys keep their order
+	template<typename T_Key, typename T_Value, typename T_Predicate>
+	inline void Sort_by_key(Vector<T_Key>& keys, Vector<T_Value>& values, T_Predicate predicate)
+	{
+		if (keys.Size() != values.Size()) throw "sort by key size mismatch";
+
+		Vector<size_t> permutation = Sort_indices(keys.Begin(), keys.End(), predicate);
+
+		Apply_permutation(keys.Begin(), keys.End(), permutation.Begin());
+		Apply_permutation(values.Begin(), values.End(), permutation.Begin());
+	}
+
+	template<typename T_Key, typename T_Value>
+	inline void Sort_by_key(Vector<T_Key>& keys, Vector<T_Value>& values)
+	{
+		Sort_by_key(keys, values, [](const T_Key& left, const T_Key& right) { return left < right; });
+	}
+
+	namespace Detail
+	{
+		struct String_ref
+		{
+			const unsigned char* data;
+			size_t size;
+		};
+
+		inline String_ref stringRef(const char* string)
+		{
+			size_t size = 0;
+			while (string[size] != '\0')
+				++size;
+
+			return String_ref{ reinterpret_cast<const unsigned char*>(string), size };
+		}
+
+		inline String_ref stringRef(const Pair<const char*, size_t>& string) { return String_ref{ reinterpret_cast<const unsigned char*>(string.First), string.Second }; }
+
+		template<typename T_String>
+		inline auto stringRef(const T_String& string) -> decltype(String_ref{ reinterpret_cast<const unsigned char*>(string.Data()), string.Size() })
+		{
+			return String_ref{ reinterpret_cast<const unsigned char*>(string.Data()), string.Size() };
+		}
+
+		inline size_t commonPrefix(const String_ref& left, const String_ref& right, size_t depth)
+		{
+			while (depth < left.size && depth < right.size && left.data[depth] == right.data[depth])
+				++depth;
+
+			return depth;
+		}
+
+		//cache holds the 7 bytes at the current depth followed by the count of those that exist,
+		//so comparing caches orders strings by those bytes with a shorter string first
+		struct String_item
+		{
+			const unsigned char* data;
+			size_t size;
+			unsigned long long cache;
+			size_t index;
+		};
+
+		const size_t String_cache_bytes = 7;
+
+		inline void loadStringCache(String_item* first, String_item* last, size_t depth)
+		{
+			for (; first != last; ++first)
+			{
+				size_t count = first->size > depth ? Min(first->size - depth, String_cache_bytes) : 0;
+				unsigned long long cache = 0;
+
+				for (size_t i = 0; i < String_cache_bytes; ++i)
+					cache = (cache << 8) | (i < count ? first->data[depth + i] : 0);
+
+				first->cache = (cache << 8) | count;
+			}
+		}
+
+		inline bool stringItemLess(const String_item& left, const String_item& right, size_t depth)
+		{
+			if (left.cache != right.cache || (left.cache & 0xFF) != String_cache_bytes) return left.cache < right.cache;
+
+			size_t prefix = commonPrefix(String_ref{ left.data, left.size }, String_ref{ right.data, right.size }, depth + String_cache_bytes);
+			return prefix == right.size ? false : prefix == left.size || left.data[prefix] < right.data[prefix];
+		}
+
+		inline void swapItems(String_item* left, String_item* right)
+		{
+			String_item temp = *left;
+			*left = *right;
+			*right = temp;
+		}
+
+		//Bentley-Sedgewick multikey quicksort over cached 7-byte chunks: three-way partition on the cache,
+		//the equal part reloads its caches at the next chunk; caches must be loaded at depth on entry.
+		//The two smaller parts are recursed into and the largest is looped on, so at most log2 n frames are live;
+		//budget counts the partitions left at one depth before a heap sort takes over, as in introsort
+		inline void multikeyQuicksort(String_item* first, String_item* last, size_t depth, size_t budget)
+		{
+			while (last - first > 16)
+			{
+				//the pivots keep splitting badly, median-of-3 killer input
+				if (budget == 0)
+				{
+					auto above = [depth](const String_item& left, const String_item& right) { return stringItemLess(right, left, depth); };
+
+					Make_heap(first, last, above);
+					for (String_item* end = last; end - first > 1; --end)
+						Pop_heap(first, end, above);
+					return;
+				}
+
+				unsigned long long a = first->cache;
+				unsigned long long b = first[(last - first) / 2].cache;
+				unsigned long long c = (last - 1)->cache;
+				unsigned long long pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+				String_item* lt = first;
+				String_item* gt = last;
+				String_item* it = first;
+
+				while (it < gt)
+				{
+					if (it->cache < pivot)
+						swapItems(lt++, it++);
+					else if (it->cache > pivot)
+						swapItems(it, --gt);
+					else
+						++it;
+				}
+
+				//the equal strings all end inside this chunk unless it is full
+				bool deeper = (pivot & 0xFF) == String_cache_bytes;
+				if (deeper)
+					loadStringCache(lt, gt, depth + String_cache_bytes);
+
+				size_t lessSize = lt - first;
+				size_t equalSize = gt - lt;
+				size_t greaterSize = last - gt;
+
+				//going one chunk deeper is progress on its own and does not use up the budget
+				if (deeper && equalSize >= lessSize && equalSize >= greaterSize)
+				{
+					multikeyQuicksort(first, lt, depth, budget - 1);
+					multikeyQuicksort(gt, last, depth, budget - 1);
+
+					first = lt;
+					last = gt;
+					depth += String_cache_bytes;
+					continue;
+				}
+
+				if (deeper)
+					multikeyQuicksort(lt, gt, depth + String_cache_bytes, budget);
+
+				--budget;
+				if (lessSize >= greaterSize)
+				{
+					multikeyQuicksort(gt, last, depth, budget);
+					last = lt;
+				}
+				else
+				{
+					multikeyQuicksort(first, lt, depth, budget);
+					first = gt;
+				}
+			}
+
+			for (String_item* i = first + 1; i < last; ++i)
+				for (String_item* j = i; j > first && stringItemLess(*j, *(j - 1), depth); --j)
+					swapItems(j - 1, j);
+		}
+	}
+
+	//sorts by the byte string returned by key, which must refer into the element:
+	//a null-terminated char pointer, a Pair<const char*, size_t> or anything with Data() and Size();
+	//elements are reordered once at the end, the sort itself only moves key references
+	template<typename T_Iterator, typename T_Key>
+	inline void Sort_strings(T_Iterator first, T_Iterator last, T_Key key)
+	{
+		size_t size = last - first;
+
+		Vector<Detail::String_item> items;
+		items.Reserve(size);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			Detail::String_ref string = Detail::stringRef(key(first[i]));
+			items.Push_back(Detail::String_item{ string.data, string.size, 0, i });
+		}
+
+		Detail::loadStringCache(items.Data(), items.Data() + size, 0);
+
+		//twice the floor of log2 size, the introsort limit
+		size_t budget = 0;
+		for (size_t count = size; count > 1; count >>= 1)
+			budget += 2;
+
+		Detail::multikeyQuicksort(items.Data(), items.Data() + size, 0, budget);
+
+		Vector<size_t> permutation;
+		permutation.Reserve(size);
+
+		for (size_t i = 0; i < size; ++i)
+			permutation.Push_back(items[i].index);
+
+		Apply_permutation(first, last, permutation.Begin());
+	}
+
+	template<typename T_Iterator>
+	inline void Sort_strings(T_Iterator first, T_Iterator last)
+	{
+		Sort_strings(first, last, [](const auto& element) -> const auto& { return element; });
+	}
+
+	//stable merge of two sorted string ranges that tracks the common prefix of both heads with the last output,
+	//so shared prefixes are scanned once per element instead of once per comparison
+	template<typename T_Iterator1, typename T_Iterator2, typename T_IteratorOutput, typename T_Key>
+	inline T_IteratorOutput Merge_strings(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Iterator2 last2, T_IteratorOutput result, T_Key key)
+	{
+		if (first1 != last1 && first2 != last2)
+		{
+			Detail::String_ref head1 = Detail::stringRef(key(*first1));
+			Detail::String_ref head2 = Detail::stringRef(key(*first2));
+			size_t prefix1 = 0;
+			size_t prefix2 = 0;
+
+			while (true)
+			{
+				bool takeFirst = prefix1 > prefix2;
+
+				if (prefix1 == prefix2)
+				{
+					size_t prefix = Detail::commonPrefix(head1, head2, prefix1);
+					takeFirst = prefix == head1.size || (prefix < head2.size && head1.data[prefix] < head2.data[prefix]);
+
+					if (takeFirst)
+						prefix2 = prefix;
+					else
+						prefix1 = prefix;
+				}
+
+				if (takeFirst)
+				{
+					*result = *first1;
+					++result;
+
+					if (++first1 == last1) break;
+
+					Detail::String_ref next = Detail::stringRef(key(*first1));
+					prefix1 = Detail::commonPrefix(head1, next, 0);
+					head1 = next;
+				}
+				else
+				{
+					*result = *first2;
+					++result;
+
+					if (++first2 == last2) break;
+
+					Detail::String_ref next = Detail::stringRef(key(*first2));
+					prefix2 = Detail::commonPrefix(head2, next, 0);
+					head2 = next;
+				}
+			}
+		}
+
+		result = Copy(first1, last1, result);
+		return Copy(first2, last2, result);
+	}
+
+	template<typename T_Iterator1, typename T_Iterator2, typename T_IteratorOutput>
+	inline T_IteratorOutput Merge_strings(T_Iterator1 first1, T_Iterator1 last1, T_Iterator2 first2, T_Iterator2 last2, T_IteratorOutput result)
+	{
+		return Merge_strings(first1, last1, first2, last2, result, [](const auto& element) -> const auto& { return element; });
+	}
 }
 
 #endif // !DVTL_ALGORITHM_H
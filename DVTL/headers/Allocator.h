@@ -0,0 +1,147 @@
+#ifndef DVTL_ALLOCATOR_H
+#define DVTL_ALLOCATOR_H
+
+#include "Utility.h"
+
+namespace DVTL 
+{
+    class Allocator 
+    {
+    public:
+        template<typename T>
+        static inline T* Allocate(const size_t& size = 1) 
+        {
+            T* ptr = static_cast<T*>(operator new(size * sizeof(T)));
+            return ptr;
+        }
+
+        template<typename T> static inline void Construct(T* const ptr, const size_t& index, const T& obj) { new (ptr + index) T(obj); }
+        template<typename T> static inline void Construct(T* const ptr, const size_t& index, T&& obj) { new (ptr + index) T(Move(obj)); }
+        template<typename T> static inline void Construct(T* const ptr, const T& obj) { new (ptr) T(obj); }
+        template<typename T> static inline void Construct(T* const ptr, T&& obj) { new (ptr) T(Move(obj)); }
+
+        template<typename T, typename... Types>
+        static inline void ConstructForward(T* const ptr, const size_t& index, Types&&... params) { new (ptr + index) T(Forward<Types>(params)...); }
+        template<typename T, typename... Types>
+        static inline void ConstructForward(T* const ptr, Types&&... params) { new (ptr) T(Forward<Types>(params)...); }
+
+        template<typename T> static inline void Destroy(T* const ptr, const size_t& index) { ptr[index].~T(); }
+        template<typename T> static inline void Destroy(T* const ptr) { ptr->~T(); }
+
+        template<typename T> static inline void Deallocate(T* const ptr) noexcept { operator delete(ptr); }
+    };
+
+    //slab allocator for objects of one type: slots come from chunks that grow geometrically,
+    //freed slots go to a free list and Release returns all chunks at once without visiting objects
+    template<typename T>
+    class Node_pool
+    {
+    public:
+        Node_pool() noexcept :m_chunks(nullptr), m_free(nullptr), m_next(nullptr), m_end(nullptr), m_chunkSlots(minChunkSlots) {}
+        Node_pool(Node_pool&& right) noexcept :Node_pool() { Swap(right); }
+        Node_pool& operator=(Node_pool&& right) noexcept { Release(); Swap(right); return *this; }
+        Node_pool(const Node_pool&) = delete;
+        Node_pool& operator=(const Node_pool&) = delete;
+        ~Node_pool() { Release(); }
+
+        //uninitialized storage for one T
+        T* Allocate()
+        {
+            if (m_free != nullptr) {
+                Slot* slot = m_free;
+                m_free = slot->next;
+                return reinterpret_cast<T*>(slot);
+            }
+
+            if (m_next == m_end) addChunk(0);
+            return reinterpret_cast<T*>(m_next++);
+        }
+
+        //uninitialized storage for count consecutive T, bypassing the free list;
+        //what is left of the current chunk when it is too small goes to the free list
+        T* Allocate(size_t count)
+        {
+            static_assert(sizeof(Slot) == sizeof(T), "consecutive slots need T at least as large as a pointer");
+
+            if (static_cast<size_t>(m_end - m_next) < count) {
+                while (m_next != m_end)
+                    Deallocate(reinterpret_cast<T*>(m_next++));
+                addChunk(count);
+            }
+
+            T* block = reinterpret_cast<T*>(m_next);
+            m_next += count;
+            return block;
+        }
+
+        //the object must already be destroyed
+        void Deallocate(T* ptr) noexcept
+        {
+            Slot* slot = reinterpret_cast<Slot*>(ptr);
+            slot->next = m_free;
+            m_free = slot;
+        }
+
+        //frees every chunk, objects still living in them are not destroyed
+        void Release() noexcept
+        {
+            while (m_chunks != nullptr) {
+                Chunk* next = m_chunks->next;
+                operator delete(m_chunks);
+                m_chunks = next;
+            }
+
+            m_free = m_next = m_end = nullptr;
+            m_chunkSlots = minChunkSlots;
+        }
+
+        void Swap(Node_pool& right) noexcept
+        {
+            Chunk* chunks = m_chunks; m_chunks = right.m_chunks; right.m_chunks = chunks;
+            Slot* free = m_free; m_free = right.m_free; right.m_free = free;
+            Slot* next = m_next; m_next = right.m_next; right.m_next = next;
+            Slot* end = m_end; m_end = right.m_end; right.m_end = end;
+            size_t chunkSlots = m_chunkSlots; m_chunkSlots = right.m_chunkSlots; right.m_chunkSlots = chunkSlots;
+        }
+    private:
+        union Slot
+        {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        struct Chunk
+        {
+            Chunk* next;
+        };
+
+        static constexpr size_t minChunkSlots = 16;
+        static constexpr size_t maxChunkSlots = 4096;
+        //slots start at the first multiple of the slot alignment after the chunk header
+        static constexpr size_t headerSize = (sizeof(Chunk) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+        Chunk* m_chunks;
+        Slot* m_free;
+        Slot* m_next;
+        Slot* m_end;
+        size_t m_chunkSlots;
+
+        //a chunk of at least minimum slots
+        void addChunk(size_t minimum)
+        {
+            static_assert(alignof(Slot) <= alignof(std::max_align_t), "over-aligned node types are not supported");
+
+            size_t slots = m_chunkSlots < minimum ? minimum : m_chunkSlots;
+            Chunk* chunk = static_cast<Chunk*>(operator new(headerSize + slots * sizeof(Slot)));
+            chunk->next = m_chunks;
+            m_chunks = chunk;
+
+            m_next = reinterpret_cast<Slot*>(reinterpret_cast<unsigned char*>(chunk) + headerSize);
+            m_end = m_next + slots;
+            if (m_chunkSlots < maxChunkSlots) m_chunkSlots *= 2;
+        }
+    };
+
+}
+
+#endif // !DVTL_ALLOCATOR_H
@@ -0,0 +1,940 @@
+#ifndef DVTL_BTREE_MAP_H
+#define DVTL_BTREE_MAP_H
+
+#include "Algorithm.h"
+#include "Allocator.h"
+
+namespace DVTL
+{
+	//ordered map with the interface of Map for large key counts: a B+ tree whose nodes take about Node_bytes,
+	//so one lookup touches a handful of nodes instead of one node per tree level of Map;
+	//elements live in linked leaves, inner nodes hold copies of separating keys and need a copyable key;
+	//elements move inside and between leaves, inserting and erasing invalidates iterators and references
+	template<typename T_Key, typename T_Value, size_t Node_bytes = 256>
+	class BTree_map
+	{
+	public:
+		//declaring iterators
+		class iterator;
+		class const_iterator;
+
+		//constructors, operators= and destructor
+		BTree_map() noexcept;
+		BTree_map(const BTree_map& right);
+		BTree_map(BTree_map&& right) noexcept;
+		BTree_map(Initializer_list<Pair<T_Key, T_Value>> init_list);
+
+		BTree_map& operator=(const BTree_map& right);
+		BTree_map& operator=(BTree_map&& right) noexcept;
+
+		~BTree_map();
+
+		//references to BTree_map elements
+		T_Value& At(const T_Key& key);
+		T_Value& operator[](const T_Key& key);
+		const T_Value& At(const T_Key& key) const;
+		const T_Value& operator[](const T_Key& key) const;
+
+		iterator Find(const T_Key& key);
+		const_iterator Find(const T_Key& key) const;
+
+		//working with data
+		void Clear();
+		inline bool Empty() const noexcept { return m_size == 0; }
+		inline size_t Size() const noexcept { return m_size; }
+		bool Contains(const T_Key& key) const;
+		void Swap(BTree_map& right) noexcept;
+
+		//adding and removing elements,
+		//inserting functions leave an existing element untouched and return it with false
+		iterator Erase(const T_Key& key);
+		Pair<iterator, bool> Insert(Pair<T_Key, T_Value>&& pair);
+		Pair<iterator, bool> Insert(const Pair<T_Key, T_Value>& pair);
+		Pair<iterator, bool> Insert(const T_Key& key, const T_Value& val);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(const T_Key& key, T_Arg&& val);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(T_Key&& key, T_Arg&& val);
+		template<class... Types> Pair<iterator, bool> Emplace(Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(const T_Key& key, Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(T_Key&& key, Types&&... args);
+
+		//getting iterators begin and end, End is one past the last element of the last leaf
+		iterator Begin()	{ return iterator(m_head, 0); }
+		iterator End()		{ return iterator(m_tail, m_tail == nullptr ? 0 : m_tail->count); }
+		const_iterator Begin()	const { return const_iterator(m_head, 0); }
+		const_iterator End()	const { return const_iterator(m_tail, m_tail == nullptr ? 0 : m_tail->count); }
+		const_iterator CBegin() const { return const_iterator(m_head, 0); }
+		const_iterator CEnd()	const { return const_iterator(m_tail, m_tail == nullptr ? 0 : m_tail->count); }
+	private:
+		typedef Pair<T_Key, T_Value> Value_type;
+		typedef Bool_constant<Is_arithmetic_v<T_Key>> Linear_search;
+
+		struct Node
+		{
+			size_t count;
+			bool leaf;
+		};
+
+		//one slot more than a node keeps, a node splits when it fills up;
+		//never less than four slots so splits and merges always have room
+		static constexpr size_t leafHeader = sizeof(Node) + 2 * sizeof(void*);
+		static constexpr size_t innerHeader = sizeof(Node) + sizeof(void*);
+		static constexpr size_t leafFit = Node_bytes > leafHeader ? (Node_bytes - leafHeader) / sizeof(Value_type) : 0;
+		static constexpr size_t innerFit = Node_bytes > innerHeader ? (Node_bytes - innerHeader) / (sizeof(T_Key) + sizeof(void*)) : 0;
+		static constexpr size_t leafSlots = leafFit < 4 ? 4 : leafFit;
+		static constexpr size_t innerSlots = innerFit < 4 ? 4 : innerFit;
+		static constexpr size_t minLeafCount = (leafSlots - 1) / 2;
+		static constexpr size_t minInnerCount = (innerSlots - 1) / 2;
+		static constexpr size_t maxDepth = 64;
+
+		struct Leaf : Node
+		{
+			Leaf* prev;
+			Leaf* next;
+			alignas(Value_type) unsigned char storage[leafSlots * sizeof(Value_type)];
+
+			Value_type* Slots() { return reinterpret_cast<Value_type*>(storage); }
+			const Value_type* Slots() const { return reinterpret_cast<const Value_type*>(storage); }
+		};
+
+		//child i holds the keys not less than key i - 1 and less than key i
+		struct Inner : Node
+		{
+			alignas(T_Key) unsigned char storage[innerSlots * sizeof(T_Key)];
+			Node* children[innerSlots + 1];
+
+			T_Key* Keys() { return reinterpret_cast<T_Key*>(storage); }
+			const T_Key* Keys() const { return reinterpret_cast<const T_Key*>(storage); }
+		};
+
+		//inner nodes visited from the root and the child taken in each of them
+		struct Path
+		{
+			Inner* nodes[maxDepth];
+			size_t index[maxDepth];
+			size_t depth;
+		};
+
+		Node* m_root;
+		Leaf* m_head;
+		Leaf* m_tail;
+		size_t m_size;
+
+		//node management
+		Leaf* createLeaf();
+		Inner* createInner();
+		void destroyNode(Node* node);
+		Node* copyNode(const Node* node, Leaf*& previous);
+
+		//searching inside a node
+		static size_t upperIndex(const Inner* node, const T_Key& key, True_type);
+		static size_t upperIndex(const Inner* node, const T_Key& key, False_type);
+		static size_t lowerIndex(const Leaf* node, const T_Key& key, True_type);
+		static size_t lowerIndex(const Leaf* node, const T_Key& key, False_type);
+
+		//moving elements inside and between nodes
+		template<typename T> static void insertSlot(T* slots, size_t count, size_t index, T&& value);
+		template<typename T> static void eraseSlot(T* slots, size_t count, size_t index);
+		template<typename T> static void moveSlots(T* source, size_t count, T* destination);
+
+		//tree operations
+		Leaf* findLeaf(const T_Key& key, size_t& index) const;
+		bool findPosition(const T_Key& key, Path& path, Leaf*& leaf, size_t& index) const;
+		iterator insertAt(Path& path, Leaf* leaf, size_t index, Value_type&& value);
+		void insertIntoParent(Path& path, Node* left, T_Key separator, Node* right);
+		void rebalanceLeaf(Path& path, Leaf* leaf, Leaf*& nextLeaf, size_t& nextIndex);
+		void rebalanceInner(Path& path, size_t depth);
+		void removeFromInner(Inner* node, size_t keyIndex);
+	};
+
+	//defining an iterator interface
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	class BTree_map<T_Key, T_Value, Node_bytes>::iterator
+	{
+	public:
+		//constructors
+		iterator(Leaf* leaf, size_t index) :m_leaf(leaf), m_index(index) {}
+
+		//logical operators
+		bool operator==(const iterator& other) const { return m_leaf == other.m_leaf && m_index == other.m_index; }
+		bool operator!=(const iterator& other) const { return !(*this == other); }
+
+		//data access
+		Pair<T_Key, T_Value>& operator*() const { return m_leaf->Slots()[m_index]; }
+		Pair<T_Key, T_Value>* operator->() const { return m_leaf->Slots() + m_index; }
+
+		//mathematical operators, decrementing End gives the last element
+		iterator& operator++()
+		{
+			if (++m_index == m_leaf->count && m_leaf->next != nullptr) {
+				m_leaf = m_leaf->next;
+				m_index = 0;
+			}
+			return *this;
+		}
+		iterator& operator--()
+		{
+			if (m_index == 0) {
+				m_leaf = m_leaf->prev;
+				m_index = m_leaf->count;
+			}
+			--m_index;
+			return *this;
+		}
+		iterator operator++(int) { iterator it(*this); ++(*this); return it; }
+		iterator operator--(int) { iterator it(*this); --(*this); return it; }
+
+		friend class BTree_map<T_Key, T_Value, Node_bytes>;
+	private:
+		Leaf* m_leaf;
+		size_t m_index;
+	};
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	class BTree_map<T_Key, T_Value, Node_bytes>::const_iterator
+	{
+	public:
+		//constructors
+		const_iterator(const Leaf* leaf, size_t index) :m_leaf(leaf), m_index(index) {}
+		const_iterator(const iterator& it) :m_leaf(it.m_leaf), m_index(it.m_index) {}
+
+		//logical operators
+		bool operator==(const const_iterator& other) const { return m_leaf == other.m_leaf && m_index == other.m_index; }
+		bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+		//data access
+		const Pair<T_Key, T_Value>& operator*() const { return m_leaf->Slots()[m_index]; }
+		const Pair<T_Key, T_Value>* operator->() const { return m_leaf->Slots() + m_index; }
+
+		//mathematical operators, decrementing End gives the last element
+		const_iterator& operator++()
+		{
+			if (++m_index == m_leaf->count && m_leaf->next != nullptr) {
+				m_leaf = m_leaf->next;
+				m_index = 0;
+			}
+			return *this;
+		}
+		const_iterator& operator--()
+		{
+			if (m_index == 0) {
+				m_leaf = m_leaf->prev;
+				m_index = m_leaf->count;
+			}
+			--m_index;
+			return *this;
+		}
+		const_iterator operator++(int) { const_iterator it(*this); ++(*this); return it; }
+		const_iterator operator--(int) { const_iterator it(*this); --(*this); return it; }
+
+		friend class BTree_map<T_Key, T_Value, Node_bytes>;
+	private:
+		const Leaf* m_leaf;
+		size_t m_index;
+	};
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline BTree_map<T_Key, T_Value, Node_bytes>::BTree_map() noexcept
+		:m_root(nullptr), m_head(nullptr), m_tail(nullptr), m_size(0) {}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline BTree_map<T_Key, T_Value, Node_bytes>::BTree_map(const BTree_map& right) :BTree_map()
+	{
+		if (right.m_root == nullptr) return;
+
+		Leaf* previous = nullptr;
+		m_root = copyNode(right.m_root, previous);
+		m_tail = previous;
+		m_size = right.m_size;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline BTree_map<T_Key, T_Value, Node_bytes>::BTree_map(BTree_map&& right) noexcept :BTree_map()
+	{
+		Swap(right);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline BTree_map<T_Key, T_Value, Node_bytes>::BTree_map(Initializer_list<Pair<T_Key, T_Value>> init_list) :BTree_map()
+	{
+		for (size_t i = 0; i < init_list.Size(); ++i)
+			Insert(*(init_list.Begin() + i));
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline BTree_map<T_Key, T_Value, Node_bytes>& BTree_map<T_Key, T_Value, Node_bytes>::operator=(const BTree_map& right)
+	{
+		if (this == &right) return *this;
+
+		BTree_map copy(right);
+		Swap(copy);
+		return *this;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline BTree_map<T_Key, T_Value, Node_bytes>& BTree_map<T_Key, T_Value, Node_bytes>::operator=(BTree_map&& right) noexcept
+	{
+		if (this == &right) return *this;
+
+		Clear();
+		Swap(right);
+		return *this;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline BTree_map<T_Key, T_Value, Node_bytes>::~BTree_map()
+	{
+		Clear();
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline T_Value& BTree_map<T_Key, T_Value, Node_bytes>::At(const T_Key& key)
+	{
+		size_t index;
+		Leaf* leaf = findLeaf(key, index);
+		if (leaf == nullptr) throw "out of range btree map";
+		return leaf->Slots()[index].Second;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline T_Value& BTree_map<T_Key, T_Value, Node_bytes>::operator[](const T_Key& key)
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline const T_Value& BTree_map<T_Key, T_Value, Node_bytes>::At(const T_Key& key) const
+	{
+		size_t index;
+		const Leaf* leaf = findLeaf(key, index);
+		if (leaf == nullptr) throw "out of range btree map";
+		return leaf->Slots()[index].Second;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline const T_Value& BTree_map<T_Key, T_Value, Node_bytes>::operator[](const T_Key& key) const
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::iterator BTree_map<T_Key, T_Value, Node_bytes>::Find(const T_Key& key)
+	{
+		size_t index;
+		Leaf* leaf = findLeaf(key, index);
+		return leaf == nullptr ? End() : iterator(leaf, index);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::const_iterator BTree_map<T_Key, T_Value, Node_bytes>::Find(const T_Key& key) const
+	{
+		size_t index;
+		const Leaf* leaf = findLeaf(key, index);
+		return leaf == nullptr ? End() : const_iterator(leaf, index);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::Clear()
+	{
+		if (m_root != nullptr) destroyNode(m_root);
+
+		m_root = nullptr;
+		m_head = nullptr;
+		m_tail = nullptr;
+		m_size = 0;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline bool BTree_map<T_Key, T_Value, Node_bytes>::Contains(const T_Key& key) const
+	{
+		size_t index;
+		return findLeaf(key, index) != nullptr;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::Swap(BTree_map& right) noexcept
+	{
+		DVTL::Swap(m_root, right.m_root);
+		DVTL::Swap(m_head, right.m_head);
+		DVTL::Swap(m_tail, right.m_tail);
+		DVTL::Swap(m_size, right.m_size);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::iterator BTree_map<T_Key, T_Value, Node_bytes>::Erase(const T_Key& key)
+	{
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (!findPosition(key, path, leaf, index)) return End();
+
+		eraseSlot(leaf->Slots(), leaf->count, index);
+		--leaf->count;
+		--m_size;
+
+		//the successor, followed through the merges and borrows below
+		Leaf* nextLeaf = leaf;
+		size_t nextIndex = index;
+		if (nextIndex == leaf->count && leaf->next != nullptr) {
+			nextLeaf = leaf->next;
+			nextIndex = 0;
+		}
+
+		if (path.depth == 0) {
+			if (leaf->count == 0) Clear();
+		}
+		else if (leaf->count < minLeafCount)
+			rebalanceLeaf(path, leaf, nextLeaf, nextIndex);
+
+		if (m_root == nullptr || (nextIndex == nextLeaf->count && nextLeaf->next == nullptr)) return End();
+		if (nextIndex == nextLeaf->count) return iterator(nextLeaf->next, 0);
+		return iterator(nextLeaf, nextIndex);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Insert(Pair<T_Key, T_Value>&& pair)
+	{
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (findPosition(pair.First, path, leaf, index)) return Pair<iterator, bool>(iterator(leaf, index), false);
+
+		return Pair<iterator, bool>(insertAt(path, leaf, index, Move(pair)), true);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Insert(const Pair<T_Key, T_Value>& pair)
+	{
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (findPosition(pair.First, path, leaf, index)) return Pair<iterator, bool>(iterator(leaf, index), false);
+
+		return Pair<iterator, bool>(insertAt(path, leaf, index, Value_type(pair)), true);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Insert(const T_Key& key, const T_Value& val)
+	{
+		return Try_emplace(key, val);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<typename T_Arg>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Insert_or_assign(const T_Key& key, T_Arg&& val)
+	{
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (findPosition(key, path, leaf, index)) {
+			leaf->Slots()[index].Second = Forward<T_Arg>(val);
+			return Pair<iterator, bool>(iterator(leaf, index), false);
+		}
+
+		return Pair<iterator, bool>(insertAt(path, leaf, index, Value_type(key, Forward<T_Arg>(val))), true);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<typename T_Arg>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Insert_or_assign(T_Key&& key, T_Arg&& val)
+	{
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (findPosition(key, path, leaf, index)) {
+			leaf->Slots()[index].Second = Forward<T_Arg>(val);
+			return Pair<iterator, bool>(iterator(leaf, index), false);
+		}
+
+		return Pair<iterator, bool>(insertAt(path, leaf, index, Value_type(Move(key), Forward<T_Arg>(val))), true);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<class... Types>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Emplace(Types&&... args)
+	{
+		//the key is only known once the element is built
+		Value_type value(Forward<Types>(args)...);
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (findPosition(value.First, path, leaf, index)) return Pair<iterator, bool>(iterator(leaf, index), false);
+
+		return Pair<iterator, bool>(insertAt(path, leaf, index, Move(value)), true);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<class... Types>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Try_emplace(const T_Key& key, Types&&... args)
+	{
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (findPosition(key, path, leaf, index)) return Pair<iterator, bool>(iterator(leaf, index), false);
+
+		return Pair<iterator, bool>(insertAt(path, leaf, index, Value_type(In_place, key, Forward<Types>(args)...)), true);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<class... Types>
+	inline Pair<typename BTree_map<T_Key, T_Value, Node_bytes>::iterator, bool> BTree_map<T_Key, T_Value, Node_bytes>::Try_emplace(T_Key&& key, Types&&... args)
+	{
+		Path path;
+		Leaf* leaf;
+		size_t index;
+		if (findPosition(key, path, leaf, index)) return Pair<iterator, bool>(iterator(leaf, index), false);
+
+		return Pair<iterator, bool>(insertAt(path, leaf, index, Value_type(In_place, Move(key), Forward<Types>(args)...)), true);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::Leaf* BTree_map<T_Key, T_Value, Node_bytes>::createLeaf()
+	{
+		Leaf* leaf = Allocator::Allocate<Leaf>();
+		leaf->count = 0;
+		leaf->leaf = true;
+		leaf->prev = nullptr;
+		leaf->next = nullptr;
+		return leaf;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::Inner* BTree_map<T_Key, T_Value, Node_bytes>::createInner()
+	{
+		Inner* inner = Allocator::Allocate<Inner>();
+		inner->count = 0;
+		inner->leaf = false;
+		return inner;
+	}
+
+	//the depth is logarithmic in the number of elements, recursion is safe here
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::destroyNode(Node* node)
+	{
+		if (node->leaf) {
+			Leaf* leaf = static_cast<Leaf*>(node);
+			if (!Is_trivially_destructible_v<Value_type>) {
+				for (size_t i = 0; i < leaf->count; ++i)
+					Allocator::Destroy(leaf->Slots() + i);
+			}
+			Allocator::Deallocate(leaf);
+			return;
+		}
+
+		Inner* inner = static_cast<Inner*>(node);
+		for (size_t i = 0; i <= inner->count; ++i)
+			destroyNode(inner->children[i]);
+		if (!Is_trivially_destructible_v<T_Key>) {
+			for (size_t i = 0; i < inner->count; ++i)
+				Allocator::Destroy(inner->Keys() + i);
+		}
+		Allocator::Deallocate(inner);
+	}
+
+	//copies in key order so the new leaves can be chained while they are created
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::Node* BTree_map<T_Key, T_Value, Node_bytes>::copyNode(const Node* node, Leaf*& previous)
+	{
+		if (node->leaf) {
+			const Leaf* source = static_cast<const Leaf*>(node);
+			Leaf* leaf = createLeaf();
+			for (; leaf->count < source->count; ++leaf->count)
+				Allocator::Construct(leaf->Slots() + leaf->count, source->Slots()[leaf->count]);
+
+			leaf->prev = previous;
+			if (previous != nullptr)
+				previous->next = leaf;
+			else
+				m_head = leaf;
+			previous = leaf;
+			return leaf;
+		}
+
+		const Inner* source = static_cast<const Inner*>(node);
+		Inner* inner = createInner();
+		for (; inner->count < source->count; ++inner->count) {
+			Allocator::Construct(inner->Keys() + inner->count, source->Keys()[inner->count]);
+			inner->children[inner->count] = copyNode(source->children[inner->count], previous);
+		}
+		inner->children[inner->count] = copyNode(source->children[inner->count], previous);
+		return inner;
+	}
+
+	//number of keys not greater than key, arithmetic keys are counted without branches so the loop vectorizes
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline size_t BTree_map<T_Key, T_Value, Node_bytes>::upperIndex(const Inner* node, const T_Key& key, True_type)
+	{
+		const T_Key* keys = node->Keys();
+		size_t index = 0;
+		for (size_t i = 0; i < node->count; ++i)
+			index += !Less(key, keys[i]);
+		return index;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline size_t BTree_map<T_Key, T_Value, Node_bytes>::upperIndex(const Inner* node, const T_Key& key, False_type)
+	{
+		const T_Key* keys = node->Keys();
+		size_t first = 0;
+		size_t count = node->count;
+
+		while (count > 0) {
+			size_t half = count / 2;
+			if (!Less(key, keys[first + half])) {
+				first += half + 1;
+				count -= half + 1;
+			}
+			else
+				count = half;
+		}
+
+		return first;
+	}
+
+	//number of elements with keys less than key
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline size_t BTree_map<T_Key, T_Value, Node_bytes>::lowerIndex(const Leaf* node, const T_Key& key, True_type)
+	{
+		const Value_type* slots = node->Slots();
+		size_t index = 0;
+		for (size_t i = 0; i < node->count; ++i)
+			index += Less(slots[i].First, key);
+		return index;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline size_t BTree_map<T_Key, T_Value, Node_bytes>::lowerIndex(const Leaf* node, const T_Key& key, False_type)
+	{
+		const Value_type* slots = node->Slots();
+		size_t first = 0;
+		size_t count = node->count;
+
+		while (count > 0) {
+			size_t half = count / 2;
+			if (Less(slots[first + half].First, key)) {
+				first += half + 1;
+				count -= half + 1;
+			}
+			else
+				count = half;
+		}
+
+		return first;
+	}
+
+	//slots below count hold objects, the slot at count is raw storage
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<typename T>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::insertSlot(T* slots, size_t count, size_t index, T&& value)
+	{
+		if (index == count) {
+			Allocator::Construct(slots + count, Move(value));
+			return;
+		}
+
+		Allocator::Construct(slots + count, Move(slots[count - 1]));
+		for (size_t i = count - 1; i > index; --i)
+			slots[i] = Move(slots[i - 1]);
+		slots[index] = Move(value);
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<typename T>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::eraseSlot(T* slots, size_t count, size_t index)
+	{
+		for (size_t i = index + 1; i < count; ++i)
+			slots[i - 1] = Move(slots[i]);
+		Allocator::Destroy(slots + count - 1);
+	}
+
+	//the destination is raw storage, the source is left as raw storage
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	template<typename T>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::moveSlots(T* source, size_t count, T* destination)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			Allocator::Construct(destination + i, Move(source[i]));
+			Allocator::Destroy(source + i);
+		}
+	}
+
+	//returns the leaf holding the key or nullptr
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::Leaf* BTree_map<T_Key, T_Value, Node_bytes>::findLeaf(const T_Key& key, size_t& index) const
+	{
+		Node* node = m_root;
+		if (node == nullptr) return nullptr;
+
+		while (!node->leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			node = inner->children[upperIndex(inner, key, Linear_search())];
+		}
+
+		Leaf* leaf = static_cast<Leaf*>(node);
+		index = lowerIndex(leaf, key, Linear_search());
+		if (index == leaf->count || Less(key, leaf->Slots()[index].First)) return nullptr;
+		return leaf;
+	}
+
+	//one descent from the root, records the path for splits and merges;
+	//returns whether the key exists and its index in the leaf or the index where it belongs
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline bool BTree_map<T_Key, T_Value, Node_bytes>::findPosition(const T_Key& key, Path& path, Leaf*& leaf, size_t& index) const
+	{
+		path.depth = 0;
+		leaf = nullptr;
+		index = 0;
+
+		Node* node = m_root;
+		if (node == nullptr) return false;
+
+		while (!node->leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			size_t child = upperIndex(inner, key, Linear_search());
+			path.nodes[path.depth] = inner;
+			path.index[path.depth] = child;
+			++path.depth;
+			node = inner->children[child];
+		}
+
+		leaf = static_cast<Leaf*>(node);
+		index = lowerIndex(leaf, key, Linear_search());
+		return index < leaf->count && !Less(key, leaf->Slots()[index].First);
+	}
+
+	//the element is built by the caller, so arguments referring to elements of this map survive the moves below
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline typename BTree_map<T_Key, T_Value, Node_bytes>::iterator BTree_map<T_Key, T_Value, Node_bytes>::insertAt(Path& path, Leaf* leaf, size_t index, Value_type&& value)
+	{
+		if (leaf == nullptr) {
+			leaf = createLeaf();
+			m_root = leaf;
+			m_head = leaf;
+			m_tail = leaf;
+		}
+
+		insertSlot(leaf->Slots(), leaf->count, index, Move(value));
+		++leaf->count;
+		++m_size;
+		if (leaf->count < leafSlots) return iterator(leaf, index);
+
+		//appending past the last key leaves the old leaf full, so ascending inserts fill their leaves
+		size_t keep = leaf->next == nullptr && index == leaf->count - 1 ? leaf->count - 1 : leaf->count / 2;
+
+		Leaf* right = createLeaf();
+		moveSlots(leaf->Slots() + keep, leaf->count - keep, right->Slots());
+		right->count = leaf->count - keep;
+		leaf->count = keep;
+
+		right->prev = leaf;
+		right->next = leaf->next;
+		if (leaf->next != nullptr)
+			leaf->next->prev = right;
+		else
+			m_tail = right;
+		leaf->next = right;
+
+		iterator result = index < keep ? iterator(leaf, index) : iterator(right, index - keep);
+		insertIntoParent(path, leaf, right->Slots()[0].First, right);
+		return result;
+	}
+
+	//adds the separator and right node next to left and splits full inner nodes up to the root
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::insertIntoParent(Path& path, Node* left, T_Key separator, Node* right)
+	{
+		while (path.depth > 0) {
+			--path.depth;
+			Inner* parent = path.nodes[path.depth];
+			size_t position = path.index[path.depth];
+
+			insertSlot(parent->Keys(), parent->count, position, Move(separator));
+			for (size_t i = parent->count + 1; i > position + 1; --i)
+				parent->children[i] = parent->children[i - 1];
+			parent->children[position + 1] = right;
+			++parent->count;
+			if (parent->count < innerSlots) return;
+
+			//the middle key moves up, the keys after it go to the new node
+			size_t middle = parent->count / 2;
+			Inner* sibling = createInner();
+			sibling->count = parent->count - middle - 1;
+			moveSlots(parent->Keys() + middle + 1, sibling->count, sibling->Keys());
+			for (size_t i = 0; i <= sibling->count; ++i)
+				sibling->children[i] = parent->children[middle + 1 + i];
+
+			separator = Move(parent->Keys()[middle]);
+			Allocator::Destroy(parent->Keys() + middle);
+			parent->count = middle;
+
+			left = parent;
+			right = sibling;
+		}
+
+		Inner* root = createInner();
+		Allocator::Construct(root->Keys(), Move(separator));
+		root->children[0] = left;
+		root->children[1] = right;
+		root->count = 1;
+		m_root = root;
+	}
+
+	//refills a leaf below the minimum from a sibling, or merges the two when they fit in one leaf;
+	//nextLeaf and nextIndex follow the element they point at
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::rebalanceLeaf(Path& path, Leaf* leaf, Leaf*& nextLeaf, size_t& nextIndex)
+	{
+		Inner* parent = path.nodes[path.depth - 1];
+		size_t position = path.index[path.depth - 1];
+		Leaf* left;
+		Leaf* right;
+		size_t separator;
+
+		if (position > 0) {
+			left = static_cast<Leaf*>(parent->children[position - 1]);
+			right = leaf;
+			separator = position - 1;
+
+			if (left->count + right->count >= leafSlots) {
+				insertSlot(right->Slots(), right->count, 0, Move(left->Slots()[left->count - 1]));
+				Allocator::Destroy(left->Slots() + left->count - 1);
+				--left->count;
+				++right->count;
+				parent->Keys()[separator] = right->Slots()[0].First;
+				if (nextLeaf == right) ++nextIndex;
+				return;
+			}
+		}
+		else {
+			left = leaf;
+			right = static_cast<Leaf*>(parent->children[position + 1]);
+			separator = position;
+
+			if (left->count + right->count >= leafSlots) {
+				Allocator::Construct(left->Slots() + left->count, Move(right->Slots()[0]));
+				eraseSlot(right->Slots(), right->count, 0);
+				++left->count;
+				--right->count;
+				parent->Keys()[separator] = right->Slots()[0].First;
+				if (nextLeaf == right) {
+					if (nextIndex == 0) {
+						nextLeaf = left;
+						nextIndex = left->count - 1;
+					}
+					else
+						--nextIndex;
+				}
+				return;
+			}
+		}
+
+		//the right leaf goes into the left one
+		if (nextLeaf == right) {
+			nextLeaf = left;
+			nextIndex += left->count;
+		}
+
+		moveSlots(right->Slots(), right->count, left->Slots() + left->count);
+		left->count += right->count;
+		left->next = right->next;
+		if (right->next != nullptr)
+			right->next->prev = left;
+		else
+			m_tail = left;
+		Allocator::Deallocate(right);
+
+		removeFromInner(parent, separator);
+		rebalanceInner(path, path.depth - 1);
+	}
+
+	//walks up from the inner node at depth while nodes fall below the minimum
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::rebalanceInner(Path& path, size_t depth)
+	{
+		while (true) {
+			Inner* node = path.nodes[depth];
+
+			if (depth == 0) {
+				//an empty root hands the tree to its only child
+				if (node->count == 0) {
+					m_root = node->children[0];
+					Allocator::Deallocate(node);
+				}
+				return;
+			}
+			if (node->count >= minInnerCount) return;
+
+			Inner* parent = path.nodes[depth - 1];
+			size_t position = path.index[depth - 1];
+			Inner* left;
+			Inner* right;
+			size_t separator;
+
+			if (position > 0) {
+				left = static_cast<Inner*>(parent->children[position - 1]);
+				right = node;
+				separator = position - 1;
+
+				//rotates the last child of the left sibling through the parent
+				if (left->count + right->count + 1 >= innerSlots) {
+					insertSlot(right->Keys(), right->count, 0, Move(parent->Keys()[separator]));
+					for (size_t i = right->count + 1; i > 0; --i)
+						right->children[i] = right->children[i - 1];
+					right->children[0] = left->children[left->count];
+					++right->count;
+
+					parent->Keys()[separator] = Move(left->Keys()[left->count - 1]);
+					Allocator::Destroy(left->Keys() + left->count - 1);
+					--left->count;
+					return;
+				}
+			}
+			else {
+				left = node;
+				right = static_cast<Inner*>(parent->children[position + 1]);
+				separator = position;
+
+				if (left->count + right->count + 1 >= innerSlots) {
+					Allocator::Construct(left->Keys() + left->count, Move(parent->Keys()[separator]));
+					left->children[left->count + 1] = right->children[0];
+					++left->count;
+
+					parent->Keys()[separator] = Move(right->Keys()[0]);
+					eraseSlot(right->Keys(), right->count, 0);
+					for (size_t i = 0; i < right->count; ++i)
+						right->children[i] = right->children[i + 1];
+					--right->count;
+					return;
+				}
+			}
+
+			//the separator comes down between the keys of both nodes
+			Allocator::Construct(left->Keys() + left->count, Move(parent->Keys()[separator]));
+			moveSlots(right->Keys(), right->count, left->Keys() + left->count + 1);
+			for (size_t i = 0; i <= right->count; ++i)
+				left->children[left->count + 1 + i] = right->children[i];
+			left->count += right->count + 1;
+			Allocator::Deallocate(right);
+
+			removeFromInner(parent, separator);
+			--depth;
+		}
+	}
+
+	//removes the key at keyIndex and the child after it
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void BTree_map<T_Key, T_Value, Node_bytes>::removeFromInner(Inner* node, size_t keyIndex)
+	{
+		eraseSlot(node->Keys(), node->count, keyIndex);
+		for (size_t i = keyIndex + 1; i < node->count; ++i)
+			node->children[i] = node->children[i + 1];
+		--node->count;
+	}
+
+	template<typename T_Key, typename T_Value, size_t Node_bytes>
+	inline void Swap(BTree_map<T_Key, T_Value, Node_bytes>& left, BTree_map<T_Key, T_Value, Node_bytes>& right)
+	{
+		left.Swap(right);
+	}
+}
+
+#endif // !DVTL_BTREE_MAP_H
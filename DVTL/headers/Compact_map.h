@@ -0,0 +1,1034 @@
+#ifndef DVTL_COMPACT_MAP_H
+#define DVTL_COMPACT_MAP_H
+
+#include "Algorithm.h"
+#include "Allocator.h"
+#include "Initializer_list.h"
+
+namespace DVTL
+{
+	namespace Detail
+	{
+		//the element comes first so small keys and values share a cache line with the links,
+		//the parent index keeps the AVL balance in its two top bits
+		template<typename T_Key, typename T_Value, bool Order_statistics>
+		struct Compact_node
+		{
+			Pair<T_Key, T_Value> data;
+			unsigned int left;
+			unsigned int right;
+			unsigned int parentAndBalance;
+		};
+
+		template<typename T_Key, typename T_Value>
+		struct Compact_node<T_Key, T_Value, true>
+		{
+			Pair<T_Key, T_Value> data;
+			unsigned int left;
+			unsigned int right;
+			unsigned int parentAndBalance;
+			unsigned int size;
+		};
+	}
+
+	//ordered map for very large key counts with the lookup, insertion, iteration and erase-by-key interface of Map,
+	//without its bound queries and range erasure: nodes live in one array and link
+	//to each other with 32-bit indices, which costs 12 bytes per entry instead of 40;
+	//the subtree sizes behind Select and Rank cost 4 more bytes and are only kept when Order_statistics is set;
+	//iterators are indices and stay valid when the array grows, references to elements do not;
+	//growing allocates an array twice as large before the old one is released, so at that moment the map
+	//holds three times the memory of its nodes: for key counts in the hundreds of millions call Reserve
+	//with the final count first, which allocates the array once
+	template<typename T_Key, typename T_Value, bool Order_statistics = false>
+	class Compact_map
+	{
+	public:
+		static constexpr size_t max_size = (1u << 30) - 1;
+
+		//declaring iterators
+		class iterator;
+		class const_iterator;
+		class reverse_iterator;
+		class const_reverse_iterator;
+
+		//constructors, operators= and destructor
+		Compact_map() noexcept;
+		Compact_map(const Compact_map& right);
+		Compact_map(Compact_map&& right) noexcept;
+		Compact_map(Initializer_list<Pair<T_Key, T_Value>> init_list);
+
+		Compact_map& operator=(const Compact_map& right);
+		Compact_map& operator=(Compact_map&& right) noexcept;
+
+		~Compact_map();
+
+		//references to Compact_map elements
+		T_Value& At(const T_Key& key);
+		T_Value& operator[](const T_Key& key);
+		const T_Value& At(const T_Key& key) const;
+		const T_Value& operator[](const T_Key& key) const;
+
+		iterator Find(const T_Key& key);
+		const_iterator Find(const T_Key& key) const;
+
+		//order statistics, need Order_statistics
+		iterator Select(size_t index);
+		const_iterator Select(size_t index) const;
+		size_t Rank(const T_Key& key) const;
+
+		//working with data
+		void Clear();
+		void Reserve(size_t count);
+		inline bool Empty() const noexcept { return m_size == 0; }
+		inline size_t Size() const noexcept { return m_size; }
+		inline size_t Capacity() const noexcept { return m_capacity; }
+		bool Contains(const T_Key& key) const;
+		void Swap(Compact_map& right) noexcept;
+
+		//adding and removing elements,
+		//inserting functions leave an existing element untouched and return it with false
+		iterator Erase(const T_Key& key);
+		Pair<iterator, bool> Insert(Pair<T_Key, T_Value>&& pair);
+		Pair<iterator, bool> Insert(const Pair<T_Key, T_Value>& pair);
+		Pair<iterator, bool> Insert(const T_Key& key, const T_Value& val);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(const T_Key& key, T_Arg&& val);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(T_Key&& key, T_Arg&& val);
+		template<class... Types> Pair<iterator, bool> Emplace(Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(const T_Key& key, Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(T_Key&& key, Types&&... args);
+
+		//getting iterators begin and end
+		iterator Begin()	{ return iterator(this, findMin(m_root)); }
+		iterator End()		{ return iterator(this, npos); }
+		reverse_iterator RBegin()	{ return reverse_iterator(this, findMax(m_root)); }
+		reverse_iterator REnd()		{ return reverse_iterator(this, npos); }
+
+		const_iterator Begin()	const { return const_iterator(this, findMin(m_root)); }
+		const_iterator End()	const { return const_iterator(this, npos); }
+		const_iterator CBegin() const { return const_iterator(this, findMin(m_root)); }
+		const_iterator CEnd()	const { return const_iterator(this, npos); }
+		const_reverse_iterator RBegin()		const { return const_reverse_iterator(this, findMax(m_root)); }
+		const_reverse_iterator REnd()		const { return const_reverse_iterator(this, npos); }
+		const_reverse_iterator CRBegin()	const { return const_reverse_iterator(this, findMax(m_root)); }
+		const_reverse_iterator CREnd()		const { return const_reverse_iterator(this, npos); }
+	private:
+		typedef unsigned int Index;
+		typedef Detail::Compact_node<T_Key, T_Value, Order_statistics> Node;
+		typedef Bool_constant<Order_statistics> Sized;
+
+		static constexpr Index npos = (1u << 30) - 1;
+		static constexpr Index parentMask = (1u << 30) - 1;
+		static constexpr Index freedMark = 3u << 30;
+
+		Node* m_nodes;
+		Index m_capacity;
+		Index m_used;		//slots below were handed out at least once
+		Index m_free;		//freed slots are chained through left
+		Index m_root;
+		Index m_size;
+
+		//links and balance
+		Index parentOf(Index index) const { return m_nodes[index].parentAndBalance & parentMask; }
+		int balanceOf(Index index) const { return static_cast<int>(m_nodes[index].parentAndBalance >> 30) - 1; }
+		void setParent(Index index, Index parent) { m_nodes[index].parentAndBalance = (m_nodes[index].parentAndBalance & ~parentMask) | parent; }
+		void setBalance(Index index, int balance) { m_nodes[index].parentAndBalance = (m_nodes[index].parentAndBalance & parentMask) | (static_cast<Index>(balance + 1) << 30); }
+		bool isFreed(Index index) const { return (m_nodes[index].parentAndBalance & freedMark) == freedMark; }
+
+		//subtree sizes, no-ops without Order_statistics
+		static Index sizeOf(const Node* nodes, Index index) { return index == npos ? 0 : nodes[index].size; }
+		void recomputeSize(Index index, True_type) { m_nodes[index].size = 1 + sizeOf(m_nodes, m_nodes[index].left) + sizeOf(m_nodes, m_nodes[index].right); }
+		void recomputeSize(Index, False_type) {}
+		void addSizeToRoot(Index index, Index delta, True_type);
+		void addSizeToRoot(Index, Index, False_type) {}
+		static void copySize(Node& target, const Node& source, True_type) { target.size = source.size; }
+		static void copySize(Node&, const Node&, False_type) {}
+		void initSize(Index index, True_type) { m_nodes[index].size = 1; }
+		void initSize(Index, False_type) {}
+
+		//slot management
+		template<class... Types> Index createNode(Types&&... args);
+		void destroyNode(Index index);
+		void destroyAll();
+		void relocate(Node* nodes, Index capacity);
+
+		//tree operations
+		Index findIndex(const T_Key& key) const;
+		Index findInsertPosition(const T_Key& key, Index& parent, bool& toLeft) const;
+		iterator linkNode(Index index, Index parent, bool toLeft);
+		void unlinkNode(Index index);
+		void replaceChild(Index parent, Index oldChild, Index newChild);
+		Index rotateLeft(Index node, Index child);
+		Index rotateRight(Index node, Index child);
+		Index rotateRightLeft(Index node, Index child);
+		Index rotateLeftRight(Index node, Index child);
+		Index findMin(Index index) const;
+		Index findMax(Index index) const;
+		Index next(Index index) const;
+		Index previous(Index index) const;
+		Index nextFromEnd(Index index) const { return index == npos ? findMin(m_root) : next(index); }
+		Index selectIndex(size_t index) const;
+	};
+
+	//defining an iterator interface
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	class Compact_map<T_Key, T_Value, Order_statistics>::iterator
+	{
+	public:
+		//constructors
+		iterator(Compact_map* map, Index index) :m_map(map), m_index(index) {}
+
+		//logical operators
+		bool operator==(const iterator& other) const { return m_index == other.m_index; }
+		bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+
+		//data access
+		Pair<T_Key, T_Value>& operator*() const { return m_map->m_nodes[m_index].data; }
+		Pair<T_Key, T_Value>* operator->() const { return &(m_map->m_nodes[m_index].data); }
+
+		//mathematical operators, decrementing End gives the last element
+		iterator& operator++() { m_index = m_map->next(m_index); return *this; }
+		iterator& operator--() { m_index = m_map->previous(m_index); return *this; }
+		iterator operator++(int) { iterator it(*this); m_index = m_map->next(m_index); return it; }
+		iterator operator--(int) { iterator it(*this); m_index = m_map->previous(m_index); return it; }
+
+		friend class Compact_map<T_Key, T_Value, Order_statistics>;
+	private:
+		Compact_map* m_map;
+		Index m_index;
+	};
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	class Compact_map<T_Key, T_Value, Order_statistics>::const_iterator
+	{
+	public:
+		//constructors
+		const_iterator(const Compact_map* map, Index index) :m_map(map), m_index(index) {}
+		const_iterator(const iterator& it) :m_map(it.m_map), m_index(it.m_index) {}
+
+		//logical operators
+		bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+		bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+		//data access
+		const Pair<T_Key, T_Value>& operator*() const { return m_map->m_nodes[m_index].data; }
+		const Pair<T_Key, T_Value>* operator->() const { return &(m_map->m_nodes[m_index].data); }
+
+		//mathematical operators, decrementing End gives the last element
+		const_iterator& operator++() { m_index = m_map->next(m_index); return *this; }
+		const_iterator& operator--() { m_index = m_map->previous(m_index); return *this; }
+		const_iterator operator++(int) { const_iterator it(*this); m_index = m_map->next(m_index); return it; }
+		const_iterator operator--(int) { const_iterator it(*this); m_index = m_map->previous(m_index); return it; }
+
+		friend class Compact_map<T_Key, T_Value, Order_statistics>;
+	private:
+		const Compact_map* m_map;
+		Index m_index;
+	};
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	class Compact_map<T_Key, T_Value, Order_statistics>::reverse_iterator
+	{
+	public:
+		//constructors
+		reverse_iterator(Compact_map* map, Index index) :m_map(map), m_index(index) {}
+		reverse_iterator(const iterator& it) :m_map(it.m_map), m_index(it.m_index) {}
+
+		//logical operators
+		bool operator==(const reverse_iterator& other) const { return m_index == other.m_index; }
+		bool operator!=(const reverse_iterator& other) const { return m_index != other.m_index; }
+
+		//data access
+		Pair<T_Key, T_Value>& operator*() const { return m_map->m_nodes[m_index].data; }
+		Pair<T_Key, T_Value>* operator->() const { return &(m_map->m_nodes[m_index].data); }
+
+		//mathematical operators, decrementing REnd gives the first element
+		reverse_iterator& operator++() { m_index = m_map->previous(m_index); return *this; }
+		reverse_iterator& operator--() { m_index = m_map->nextFromEnd(m_index); return *this; }
+		reverse_iterator operator++(int) { reverse_iterator it(*this); m_index = m_map->previous(m_index); return it; }
+		reverse_iterator operator--(int) { reverse_iterator it(*this); m_index = m_map->nextFromEnd(m_index); return it; }
+
+		//transformation
+		iterator get_revers() const { return iterator(m_map, m_index); }
+
+		friend class Compact_map<T_Key, T_Value, Order_statistics>;
+	private:
+		Compact_map* m_map;
+		Index m_index;
+	};
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	class Compact_map<T_Key, T_Value, Order_statistics>::const_reverse_iterator
+	{
+	public:
+		//constructors
+		const_reverse_iterator(const Compact_map* map, Index index) :m_map(map), m_index(index) {}
+		const_reverse_iterator(const reverse_iterator& it) :m_map(it.m_map), m_index(it.m_index) {}
+		const_reverse_iterator(const const_iterator& it) :m_map(it.m_map), m_index(it.m_index) {}
+
+		//logical operators
+		bool operator==(const const_reverse_iterator& other) const { return m_index == other.m_index; }
+		bool operator!=(const const_reverse_iterator& other) const { return m_index != other.m_index; }
+
+		//data access
+		const Pair<T_Key, T_Value>& operator*() const { return m_map->m_nodes[m_index].data; }
+		const Pair<T_Key, T_Value>* operator->() const { return &(m_map->m_nodes[m_index].data); }
+
+		//mathematical operators, decrementing REnd gives the first element
+		const_reverse_iterator& operator++() { m_index = m_map->previous(m_index); return *this; }
+		const_reverse_iterator& operator--() { m_index = m_map->nextFromEnd(m_index); return *this; }
+		const_reverse_iterator operator++(int) { const_reverse_iterator it(*this); m_index = m_map->previous(m_index); return it; }
+		const_reverse_iterator operator--(int) { const_reverse_iterator it(*this); m_index = m_map->nextFromEnd(m_index); return it; }
+
+		//transformation
+		const_iterator get_revers() const { return const_iterator(m_map, m_index); }
+
+		friend class Compact_map<T_Key, T_Value, Order_statistics>;
+	private:
+		const Compact_map* m_map;
+		Index m_index;
+	};
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Compact_map<T_Key, T_Value, Order_statistics>::Compact_map() noexcept
+		:m_nodes(nullptr), m_capacity(0), m_used(0), m_free(npos), m_root(npos), m_size(0) {}
+
+	//slots keep their indices, so the copy shares the layout and free list of the source
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Compact_map<T_Key, T_Value, Order_statistics>::Compact_map(const Compact_map& right) :Compact_map()
+	{
+		if (right.m_used == 0) return;
+
+		m_nodes = Allocator::Allocate<Node>(right.m_used);
+		m_capacity = right.m_used;
+
+		for (; m_used < right.m_used; ++m_used) {
+			Node& node = m_nodes[m_used];
+			const Node& source = right.m_nodes[m_used];
+			if (!right.isFreed(m_used)) Allocator::Construct(&node.data, source.data);
+			node.left = source.left;
+			node.right = source.right;
+			node.parentAndBalance = source.parentAndBalance;
+			copySize(node, source, Sized());
+		}
+
+		m_free = right.m_free;
+		m_root = right.m_root;
+		m_size = right.m_size;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Compact_map<T_Key, T_Value, Order_statistics>::Compact_map(Compact_map&& right) noexcept :Compact_map()
+	{
+		Swap(right);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Compact_map<T_Key, T_Value, Order_statistics>::Compact_map(Initializer_list<Pair<T_Key, T_Value>> init_list) :Compact_map()
+	{
+		Reserve(init_list.Size());
+		for (size_t i = 0; i < init_list.Size(); ++i)
+			Insert(*(init_list.Begin() + i));
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Compact_map<T_Key, T_Value, Order_statistics>& Compact_map<T_Key, T_Value, Order_statistics>::operator=(const Compact_map& right)
+	{
+		if (this == &right) return *this;
+
+		Compact_map copy(right);
+		Swap(copy);
+		return *this;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Compact_map<T_Key, T_Value, Order_statistics>& Compact_map<T_Key, T_Value, Order_statistics>::operator=(Compact_map&& right) noexcept
+	{
+		if (this == &right) return *this;
+
+		destroyAll();
+		Swap(right);
+		return *this;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Compact_map<T_Key, T_Value, Order_statistics>::~Compact_map()
+	{
+		destroyAll();
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline T_Value& Compact_map<T_Key, T_Value, Order_statistics>::At(const T_Key& key)
+	{
+		Index index = findIndex(key);
+		if (index == npos) throw "out of range compact map";
+		return m_nodes[index].data.Second;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline T_Value& Compact_map<T_Key, T_Value, Order_statistics>::operator[](const T_Key& key)
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline const T_Value& Compact_map<T_Key, T_Value, Order_statistics>::At(const T_Key& key) const
+	{
+		Index index = findIndex(key);
+		if (index == npos) throw "out of range compact map";
+		return m_nodes[index].data.Second;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline const T_Value& Compact_map<T_Key, T_Value, Order_statistics>::operator[](const T_Key& key) const
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::iterator Compact_map<T_Key, T_Value, Order_statistics>::Find(const T_Key& key)
+	{
+		return iterator(this, findIndex(key));
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::const_iterator Compact_map<T_Key, T_Value, Order_statistics>::Find(const T_Key& key) const
+	{
+		return const_iterator(this, findIndex(key));
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::iterator Compact_map<T_Key, T_Value, Order_statistics>::Select(size_t index)
+	{
+		return iterator(this, selectIndex(index));
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::const_iterator Compact_map<T_Key, T_Value, Order_statistics>::Select(size_t index) const
+	{
+		return const_iterator(this, selectIndex(index));
+	}
+
+	//number of keys less than key
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline size_t Compact_map<T_Key, T_Value, Order_statistics>::Rank(const T_Key& key) const
+	{
+		static_assert(Order_statistics, "Rank needs a Compact_map with Order_statistics");
+
+		size_t rank = 0;
+		Index index = m_root;
+
+		while (index != npos) {
+			const Node& node = m_nodes[index];
+			if (Less(node.data.First, key)) {
+				rank += 1 + sizeOf(m_nodes, node.left);
+				index = node.right;
+			}
+			else
+				index = node.left;
+		}
+
+		return rank;
+	}
+
+	//destroys the elements and keeps the node array
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::Clear()
+	{
+		if (!Is_trivially_destructible_v<Pair<T_Key, T_Value>>) {
+			for (Index index = 0; index < m_used; ++index)
+				if (!isFreed(index)) Allocator::Destroy(&m_nodes[index].data);
+		}
+
+		m_used = 0;
+		m_free = npos;
+		m_root = npos;
+		m_size = 0;
+	}
+
+	//allocates exactly count slots in one step, the way to fill very large maps without the peaks of doubling
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::Reserve(size_t count)
+	{
+		if (count > max_size) throw "compact map capacity exceeded";
+		if (count > m_capacity) relocate(Allocator::Allocate<Node>(count), static_cast<Index>(count));
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline bool Compact_map<T_Key, T_Value, Order_statistics>::Contains(const T_Key& key) const
+	{
+		return findIndex(key) != npos;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::Swap(Compact_map& right) noexcept
+	{
+		DVTL::Swap(m_nodes, right.m_nodes);
+		DVTL::Swap(m_capacity, right.m_capacity);
+		DVTL::Swap(m_used, right.m_used);
+		DVTL::Swap(m_free, right.m_free);
+		DVTL::Swap(m_root, right.m_root);
+		DVTL::Swap(m_size, right.m_size);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::iterator Compact_map<T_Key, T_Value, Order_statistics>::Erase(const T_Key& key)
+	{
+		Index index = findIndex(key);
+		if (index == npos) return End();
+
+		//unlinking moves links and not elements, so the successor keeps its index
+		Index successor = next(index);
+		unlinkNode(index);
+		destroyNode(index);
+		return iterator(this, successor);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Insert(Pair<T_Key, T_Value>&& pair)
+	{
+		Index parent;
+		bool toLeft;
+		Index index = findInsertPosition(pair.First, parent, toLeft);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(linkNode(createNode(Move(pair)), parent, toLeft), true);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Insert(const Pair<T_Key, T_Value>& pair)
+	{
+		Index parent;
+		bool toLeft;
+		Index index = findInsertPosition(pair.First, parent, toLeft);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(linkNode(createNode(pair), parent, toLeft), true);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Insert(const T_Key& key, const T_Value& val)
+	{
+		return Try_emplace(key, val);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	template<typename T_Arg>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Insert_or_assign(const T_Key& key, T_Arg&& val)
+	{
+		Pair<iterator, bool> result = Try_emplace(key, Forward<T_Arg>(val));
+		if (!result.Second) result.First->Second = Forward<T_Arg>(val);
+		return result;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	template<typename T_Arg>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Insert_or_assign(T_Key&& key, T_Arg&& val)
+	{
+		Pair<iterator, bool> result = Try_emplace(Move(key), Forward<T_Arg>(val));
+		if (!result.Second) result.First->Second = Forward<T_Arg>(val);
+		return result;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	template<class... Types>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Emplace(Types&&... args)
+	{
+		//the key is only known once the element is built
+		Index created = createNode(Forward<Types>(args)...);
+		Index parent;
+		bool toLeft;
+		Index index = findInsertPosition(m_nodes[created].data.First, parent, toLeft);
+
+		if (index != npos) {
+			destroyNode(created);
+			return Pair<iterator, bool>(iterator(this, index), false);
+		}
+
+		return Pair<iterator, bool>(linkNode(created, parent, toLeft), true);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	template<class... Types>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Try_emplace(const T_Key& key, Types&&... args)
+	{
+		Index parent;
+		bool toLeft;
+		Index index = findInsertPosition(key, parent, toLeft);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(linkNode(createNode(In_place, key, Forward<Types>(args)...), parent, toLeft), true);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	template<class... Types>
+	inline Pair<typename Compact_map<T_Key, T_Value, Order_statistics>::iterator, bool> Compact_map<T_Key, T_Value, Order_statistics>::Try_emplace(T_Key&& key, Types&&... args)
+	{
+		Index parent;
+		bool toLeft;
+		Index index = findInsertPosition(key, parent, toLeft);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(linkNode(createNode(In_place, Move(key), Forward<Types>(args)...), parent, toLeft), true);
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::addSizeToRoot(Index index, Index delta, True_type)
+	{
+		for (; index != npos; index = parentOf(index))
+			m_nodes[index].size += delta;
+	}
+
+	//the new node is not linked yet; when the array is full the element is built in the new array
+	//before the old one is released, so arguments may refer to elements of this map
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	template<class... Types>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::createNode(Types&&... args)
+	{
+		Index index;
+
+		if (m_free != npos) {
+			index = m_free;
+			m_free = m_nodes[index].left;
+			Allocator::ConstructForward(&m_nodes[index].data, Forward<Types>(args)...);
+		}
+		else if (m_used < m_capacity) {
+			index = m_used++;
+			Allocator::ConstructForward(&m_nodes[index].data, Forward<Types>(args)...);
+		}
+		else {
+			if (m_capacity == max_size) throw "compact map capacity exceeded";
+			size_t capacity = m_capacity < 8 ? 16 : static_cast<size_t>(m_capacity) * 2;
+			if (capacity > max_size) capacity = max_size;
+
+			Node* nodes = Allocator::Allocate<Node>(capacity);
+			Allocator::ConstructForward(&nodes[m_used].data, Forward<Types>(args)...);
+			relocate(nodes, static_cast<Index>(capacity));
+			index = m_used++;
+		}
+
+		Node& node = m_nodes[index];
+		node.left = npos;
+		node.right = npos;
+		node.parentAndBalance = npos | (1u << 30);
+		initSize(index, Sized());
+		++m_size;
+		return index;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::destroyNode(Index index)
+	{
+		Node& node = m_nodes[index];
+		Allocator::Destroy(&node.data);
+		node.parentAndBalance = freedMark | npos;
+		node.left = m_free;
+		m_free = index;
+		--m_size;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::destroyAll()
+	{
+		Clear();
+		Allocator::Deallocate(m_nodes);
+		m_nodes = nullptr;
+		m_capacity = 0;
+	}
+
+	//moves the elements of used slots into a larger array, links are indices and stay as they are
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::relocate(Node* nodes, Index capacity)
+	{
+		for (Index index = 0; index < m_used; ++index) {
+			Node& node = nodes[index];
+			Node& source = m_nodes[index];
+			if (!isFreed(index)) {
+				Allocator::Construct(&node.data, Move(source.data));
+				Allocator::Destroy(&source.data);
+			}
+			node.left = source.left;
+			node.right = source.right;
+			node.parentAndBalance = source.parentAndBalance;
+			copySize(node, source, Sized());
+		}
+
+		Allocator::Deallocate(m_nodes);
+		m_nodes = nodes;
+		m_capacity = capacity;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::findIndex(const T_Key& key) const
+	{
+		Index index = m_root;
+
+		while (index != npos) {
+			const Node& node = m_nodes[index];
+			if (Less(node.data.First, key))
+				index = node.right;
+			else if (Less(key, node.data.First))
+				index = node.left;
+			else
+				break;
+		}
+
+		return index;
+	}
+
+	//one descent from the root, returns the index holding the key
+	//or npos and the parent and side where a node with the key belongs
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::findInsertPosition(const T_Key& key, Index& parent, bool& toLeft) const
+	{
+		Index index = m_root;
+		parent = npos;
+		toLeft = false;
+
+		while (index != npos) {
+			const Node& node = m_nodes[index];
+			parent = index;
+			if (Less(key, node.data.First)) {
+				toLeft = true;
+				index = node.left;
+			}
+			else if (Less(node.data.First, key)) {
+				toLeft = false;
+				index = node.right;
+			}
+			else
+				return index;
+		}
+
+		return npos;
+	}
+
+	//attaches a new leaf and walks up updating balances until a subtree keeps its height
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::iterator Compact_map<T_Key, T_Value, Order_statistics>::linkNode(Index index, Index parent, bool toLeft)
+	{
+		setParent(index, parent);
+
+		if (parent == npos) {
+			m_root = index;
+			return iterator(this, index);
+		}
+
+		if (toLeft)
+			m_nodes[parent].left = index;
+		else
+			m_nodes[parent].right = index;
+		addSizeToRoot(parent, 1, Sized());
+
+		Index child = index;
+		for (Index node = parent; node != npos; node = parentOf(child)) {
+			int balance = balanceOf(node);
+
+			if (m_nodes[node].left == child) {
+				if (balance < 0) {
+					Index grandparent = parentOf(node);
+					Index subtree = balanceOf(child) > 0 ? rotateLeftRight(node, child) : rotateRight(node, child);
+					replaceChild(grandparent, node, subtree);
+					break;
+				}
+				if (balance > 0) {
+					setBalance(node, 0);
+					break;
+				}
+				setBalance(node, -1);
+			}
+			else {
+				if (balance > 0) {
+					Index grandparent = parentOf(node);
+					Index subtree = balanceOf(child) < 0 ? rotateRightLeft(node, child) : rotateLeft(node, child);
+					replaceChild(grandparent, node, subtree);
+					break;
+				}
+				if (balance < 0) {
+					setBalance(node, 0);
+					break;
+				}
+				setBalance(node, 1);
+			}
+
+			child = node;
+		}
+
+		return iterator(this, index);
+	}
+
+	//takes a node out of the tree and rebalances, the node itself stays allocated
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::unlinkNode(Index index)
+	{
+		Node& node = m_nodes[index];
+		Index retraceFrom;
+		bool fromLeft;
+
+		if (node.left != npos && node.right != npos) {
+			//the successor takes the place, balance and size of the node
+			Index successor = findMin(node.right);
+
+			if (parentOf(successor) == index) {
+				retraceFrom = successor;
+				fromLeft = false;
+			}
+			else {
+				Index successorParent = parentOf(successor);
+				Index successorRight = m_nodes[successor].right;
+				m_nodes[successorParent].left = successorRight;
+				if (successorRight != npos) setParent(successorRight, successorParent);
+
+				m_nodes[successor].right = node.right;
+				setParent(node.right, successor);
+				retraceFrom = successorParent;
+				fromLeft = true;
+			}
+
+			m_nodes[successor].left = node.left;
+			setParent(node.left, successor);
+			setBalance(successor, balanceOf(index));
+			copySize(m_nodes[successor], m_nodes[index], Sized());
+			replaceChild(parentOf(index), index, successor);
+		}
+		else {
+			Index child = node.left != npos ? node.left : node.right;
+			retraceFrom = parentOf(index);
+			fromLeft = retraceFrom != npos && m_nodes[retraceFrom].left == index;
+			replaceChild(retraceFrom, index, child);
+		}
+
+		addSizeToRoot(retraceFrom, static_cast<Index>(-1), Sized());
+
+		//walks up while the height of the visited subtree shrinks
+		for (Index current = retraceFrom; current != npos;) {
+			Index grandparent = parentOf(current);
+			bool grandparentFromLeft = grandparent != npos && m_nodes[grandparent].left == current;
+			int balance = balanceOf(current);
+
+			if (fromLeft) {
+				if (balance == 0) {
+					setBalance(current, 1);
+					return;
+				}
+				if (balance < 0)
+					setBalance(current, 0);
+				else {
+					Index sibling = m_nodes[current].right;
+					int siblingBalance = balanceOf(sibling);
+					Index subtree = siblingBalance < 0 ? rotateRightLeft(current, sibling) : rotateLeft(current, sibling);
+					replaceChild(grandparent, current, subtree);
+					if (siblingBalance == 0) return;
+				}
+			}
+			else {
+				if (balance == 0) {
+					setBalance(current, -1);
+					return;
+				}
+				if (balance > 0)
+					setBalance(current, 0);
+				else {
+					Index sibling = m_nodes[current].left;
+					int siblingBalance = balanceOf(sibling);
+					Index subtree = siblingBalance > 0 ? rotateLeftRight(current, sibling) : rotateRight(current, sibling);
+					replaceChild(grandparent, current, subtree);
+					if (siblingBalance == 0) return;
+				}
+			}
+
+			current = grandparent;
+			fromLeft = grandparentFromLeft;
+		}
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Compact_map<T_Key, T_Value, Order_statistics>::replaceChild(Index parent, Index oldChild, Index newChild)
+	{
+		if (newChild != npos) setParent(newChild, parent);
+
+		if (parent == npos)
+			m_root = newChild;
+		else if (m_nodes[parent].left == oldChild)
+			m_nodes[parent].left = newChild;
+		else
+			m_nodes[parent].right = newChild;
+	}
+
+	//rotations return the new subtree root, the caller links it to the old parent
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::rotateLeft(Index node, Index child)
+	{
+		Index inner = m_nodes[child].left;
+		m_nodes[node].right = inner;
+		if (inner != npos) setParent(inner, node);
+		m_nodes[child].left = node;
+		setParent(node, child);
+
+		//a balanced child only happens when erasing
+		if (balanceOf(child) == 0) {
+			setBalance(node, 1);
+			setBalance(child, -1);
+		}
+		else {
+			setBalance(node, 0);
+			setBalance(child, 0);
+		}
+
+		recomputeSize(node, Sized());
+		recomputeSize(child, Sized());
+		return child;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::rotateRight(Index node, Index child)
+	{
+		Index inner = m_nodes[child].right;
+		m_nodes[node].left = inner;
+		if (inner != npos) setParent(inner, node);
+		m_nodes[child].right = node;
+		setParent(node, child);
+
+		if (balanceOf(child) == 0) {
+			setBalance(node, -1);
+			setBalance(child, 1);
+		}
+		else {
+			setBalance(node, 0);
+			setBalance(child, 0);
+		}
+
+		recomputeSize(node, Sized());
+		recomputeSize(child, Sized());
+		return child;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::rotateRightLeft(Index node, Index child)
+	{
+		Index middle = m_nodes[child].left;
+
+		Index inner = m_nodes[middle].right;
+		m_nodes[child].left = inner;
+		if (inner != npos) setParent(inner, child);
+		m_nodes[middle].right = child;
+		setParent(child, middle);
+
+		inner = m_nodes[middle].left;
+		m_nodes[node].right = inner;
+		if (inner != npos) setParent(inner, node);
+		m_nodes[middle].left = node;
+		setParent(node, middle);
+
+		int balance = balanceOf(middle);
+		setBalance(node, balance > 0 ? -1 : 0);
+		setBalance(child, balance < 0 ? 1 : 0);
+		setBalance(middle, 0);
+
+		recomputeSize(node, Sized());
+		recomputeSize(child, Sized());
+		recomputeSize(middle, Sized());
+		return middle;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::rotateLeftRight(Index node, Index child)
+	{
+		Index middle = m_nodes[child].right;
+
+		Index inner = m_nodes[middle].left;
+		m_nodes[child].right = inner;
+		if (inner != npos) setParent(inner, child);
+		m_nodes[middle].left = child;
+		setParent(child, middle);
+
+		inner = m_nodes[middle].right;
+		m_nodes[node].left = inner;
+		if (inner != npos) setParent(inner, node);
+		m_nodes[middle].right = node;
+		setParent(node, middle);
+
+		int balance = balanceOf(middle);
+		setBalance(node, balance < 0 ? 1 : 0);
+		setBalance(child, balance > 0 ? -1 : 0);
+		setBalance(middle, 0);
+
+		recomputeSize(node, Sized());
+		recomputeSize(child, Sized());
+		recomputeSize(middle, Sized());
+		return middle;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::findMin(Index index) const
+	{
+		if (index == npos) return npos;
+		while (m_nodes[index].left != npos)
+			index = m_nodes[index].left;
+		return index;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::findMax(Index index) const
+	{
+		if (index == npos) return npos;
+		while (m_nodes[index].right != npos)
+			index = m_nodes[index].right;
+		return index;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::next(Index index) const
+	{
+		if (index == npos) return npos;
+		if (m_nodes[index].right != npos) return findMin(m_nodes[index].right);
+
+		Index parent = parentOf(index);
+		while (parent != npos && m_nodes[parent].right == index) {
+			index = parent;
+			parent = parentOf(index);
+		}
+		return parent;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::previous(Index index) const
+	{
+		if (index == npos) return findMax(m_root);
+		if (m_nodes[index].left != npos) return findMax(m_nodes[index].left);
+
+		Index parent = parentOf(index);
+		while (parent != npos && m_nodes[parent].left == index) {
+			index = parent;
+			parent = parentOf(index);
+		}
+		return parent;
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline typename Compact_map<T_Key, T_Value, Order_statistics>::Index Compact_map<T_Key, T_Value, Order_statistics>::selectIndex(size_t index) const
+	{
+		static_assert(Order_statistics, "Select needs a Compact_map with Order_statistics");
+		if (index >= m_size) return npos;
+
+		Index current = m_root;
+		while (true) {
+			size_t leftSize = sizeOf(m_nodes, m_nodes[current].left);
+			if (index < leftSize)
+				current = m_nodes[current].left;
+			else if (index == leftSize)
+				return current;
+			else {
+				index -= leftSize + 1;
+				current = m_nodes[current].right;
+			}
+		}
+	}
+
+	template<typename T_Key, typename T_Value, bool Order_statistics>
+	inline void Swap(Compact_map<T_Key, T_Value, Order_statistics>& left, Compact_map<T_Key, T_Value, Order_statistics>& right)
+	{
+		left.Swap(right);
+	}
+}
+
+#endif // !DVTL_COMPACT_MAP_H
@@ -0,0 +1,286 @@
+#ifndef DVTL_EXTERNAL_SORT_H
+#define DVTL_EXTERNAL_SORT_H
+
+#include <cstdio>
+#include <thread>
+
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace DVTL
+{
+	struct External_sort_options
+	{
+		size_t runRecords = size_t(1) << 20;	//records sorted in memory per run, two run buffers are allocated
+		size_t fanIn = 64;						//runs merged at once
+		size_t blockRecords = size_t(1) << 14;	//records buffered per run file while merging
+	};
+
+	namespace Detail
+	{
+		//buffered sequential reader over a run file
+		template<typename T_Record>
+		class Run_reader
+		{
+		public:
+			Run_reader(FILE* file, size_t blockRecords) :m_file(file), m_buffer(blockRecords), m_position(0), m_count(0) { refill(); }
+
+			bool Exhausted() const { return m_position == m_count; }
+			const T_Record& Current() const { return m_buffer[m_position]; }
+
+			void Advance()
+			{
+				if (++m_position == m_count)
+					refill();
+			}
+		private:
+			FILE* m_file;
+			Vector<T_Record> m_buffer;
+			size_t m_position;
+			size_t m_count;
+
+			void refill()
+			{
+				m_position = 0;
+				m_count = fread(m_buffer.Data(), sizeof(T_Record), m_buffer.Size(), m_file);
+				if (m_count < m_buffer.Size() && ferror(m_file)) throw "external sort read error";
+			}
+		};
+
+		//input iterator over a Run_reader, a default cursor is the end of every run
+		template<typename T_Record>
+		class Run_cursor
+		{
+		public:
+			Run_cursor() :m_reader(nullptr) {}
+			explicit Run_cursor(Run_reader<T_Record>* reader) :m_reader(reader) {}
+
+			bool operator==(const Run_cursor& other) const { return atEnd() == other.atEnd(); }
+			bool operator!=(const Run_cursor& other) const { return atEnd() != other.atEnd(); }
+
+			const T_Record& operator*() const { return m_reader->Current(); }
+			Run_cursor& operator++() { m_reader->Advance(); return *this; }
+		private:
+			Run_reader<T_Record>* m_reader;
+
+			bool atEnd() const { return m_reader == nullptr || m_reader->Exhausted(); }
+		};
+
+		//buffered sequential writer to a run file
+		template<typename T_Record>
+		class Run_output
+		{
+		public:
+			Run_output(FILE* file, size_t blockRecords) :m_file(file), m_buffer(blockRecords), m_count(0) {}
+
+			void Push(const T_Record& record)
+			{
+				m_buffer[m_count++] = record;
+				if (m_count == m_buffer.Size()) Flush();
+			}
+
+			void Flush()
+			{
+				if (m_count != 0 && fwrite(m_buffer.Data(), sizeof(T_Record), m_count, m_file) != m_count)
+					throw "external sort write error";
+				m_count = 0;
+			}
+		private:
+			FILE* m_file;
+			Vector<T_Record> m_buffer;
+			size_t m_count;
+		};
+
+		//output iterator over a Run_output
+		template<typename T_Record>
+		class Run_writer
+		{
+		public:
+			explicit Run_writer(Run_output<T_Record>* output) :m_output(output) {}
+
+			Run_writer& operator*() { return *this; }
+			Run_writer& operator++() { return *this; }
+			Run_writer& operator=(const T_Record& record) { m_output->Push(record); return *this; }
+		private:
+			Run_output<T_Record>* m_output;
+		};
+
+		template<typename T_Record, typename T_Predicate>
+		inline void mergeRuns(FILE** first, FILE** last, FILE* output, T_Predicate& predicate, size_t blockRecords)
+		{
+			size_t count = static_cast<size_t>(last - first);
+
+			Vector<Run_reader<T_Record>> readers;
+			readers.Reserve(count);
+			for (FILE** it = first; it != last; ++it)
+			{
+				rewind(*it);
+				readers.Emplace_back(*it, blockRecords);
+			}
+
+			Vector<Pair<Run_cursor<T_Record>, Run_cursor<T_Record>>> runs;
+			runs.Reserve(count);
+			for (size_t i = 0; i < count; ++i)
+				runs.Emplace_back(Run_cursor<T_Record>(&readers[i]), Run_cursor<T_Record>());
+
+			Run_output<T_Record> writer(output, blockRecords);
+			Merge_k(runs.Begin(), runs.End(), Run_writer<T_Record>(&writer), predicate);
+			writer.Flush();
+		}
+	}
+
+	//sorts a stream of fixed-size trivially copyable records that does not fit in memory:
+	//sorted runs are spilled to temporary files and merged back fanIn runs at a time,
+	//reading the next run overlaps with sorting and spilling the current one
+	template<typename T_Record, typename T_Predicate>
+	inline void External_sort(FILE* input, FILE* output, T_Predicate predicate, const External_sort_options& options = External_sort_options())
+	{
+		size_t runRecords = Max<size_t>(options.runRecords, 1);
+		size_t fanIn = Max<size_t>(options.fanIn, 2);
+		size_t blockRecords = Max<size_t>(options.blockRecords, 1);
+
+		Vector<T_Record> current(runRecords);
+		Vector<T_Record> next(runRecords);
+		Vector<FILE*> runs;
+
+		auto readRun = [input](Vector<T_Record>& buffer) {
+			size_t count = fread(buffer.Data(), sizeof(T_Record), buffer.Size(), input);
+			if (count < buffer.Size() && ferror(input)) throw "external sort read error";
+			return count;
+		};
+
+		size_t count = readRun(current);
+
+		try
+		{
+			while (count != 0)
+			{
+				size_t nextCount = 0;
+				std::thread reader([&]() { nextCount = fread(next.Data(), sizeof(T_Record), next.Size(), input); });
+
+				//the reader must be joined before anything leaves this scope, a joinable thread terminates on destruction
+				bool written;
+				try
+				{
+					Sort(current.Data(), current.Data() + count, predicate);
+
+					//the whole input fit in one run
+					FILE* target = output;
+					if (!runs.Empty() || count == runRecords)
+					{
+						//room first, so the new file is never held outside runs
+						if (runs.Size() == runs.Capacity()) runs.Reserve(runs.Size() * 2 + 8);
+						target = tmpfile();
+						if (target == nullptr) throw "external sort cannot create a temporary file";
+						runs.Push_back(target);
+					}
+
+					written = fwrite(current.Data(), sizeof(T_Record), count, target) == count;
+				}
+				catch (...)
+				{
+					reader.join();
+					throw;
+				}
+				reader.join();
+
+				if (!written) throw "external sort write error";
+				if (nextCount < next.Size() && ferror(input)) throw "external sort read error";
+
+				current.Swap(next);
+				count = nextCount;
+			}
+
+			if (!runs.Empty())
+			{
+				//release the run buffers before merging
+				Vector<T_Record>().Swap(current);
+				Vector<T_Record>().Swap(next);
+
+				while (runs.Size() > fanIn)
+				{
+					//reserved up front, so a new run is never left outside merged;
+					//runs already merged are closed and null, the outer catch closes the rest
+					Vector<FILE*> merged;
+					merged.Reserve((runs.Size() + fanIn - 1) / fanIn);
+
+					try
+					{
+						for (size_t first = 0; first < runs.Size(); first += fanIn)
+						{
+							size_t last = Min(first + fanIn, runs.Size());
+							FILE* target = tmpfile();
+							if (target == nullptr) throw "external sort cannot create a temporary file";
+							merged.Push_back(target);
+
+							Detail::mergeRuns<T_Record>(runs.Data() + first, runs.Data() + last, target, predicate, blockRecords);
+
+							for (size_t i = first; i < last; ++i)
+							{
+								fclose(runs[i]);
+								runs[i] = nullptr;
+							}
+						}
+					}
+					catch (...)
+					{
+						for (size_t i = 0; i < merged.Size(); ++i)
+							fclose(merged[i]);
+						throw;
+					}
+
+					runs.Swap(merged);
+				}
+
+				Detail::mergeRuns<T_Record>(runs.Data(), runs.Data() + runs.Size(), output, predicate, blockRecords);
+			}
+		}
+		catch (...)
+		{
+			for (size_t i = 0; i < runs.Size(); ++i)
+				if (runs[i] != nullptr) fclose(runs[i]);
+			throw;
+		}
+
+		for (size_t i = 0; i < runs.Size(); ++i)
+			fclose(runs[i]);
+
+		fflush(output);
+	}
+
+	template<typename T_Record>
+	inline void External_sort(FILE* input, FILE* output, const External_sort_options& options = External_sort_options())
+	{
+		External_sort<T_Record>(input, output, [](const T_Record& left, const T_Record& right) { return left < right; }, options);
+	}
+
+	template<typename T_Record, typename T_Predicate>
+	inline void External_sort(const char* inputPath, const char* outputPath, T_Predicate predicate, const External_sort_options& options = External_sort_options())
+	{
+		FILE* input = fopen(inputPath, "rb");
+		if (input == nullptr) throw "external sort cannot open the input file";
+
+		FILE* output = fopen(outputPath, "wb");
+		if (output == nullptr)
+		{
+			fclose(input);
+			throw "external sort cannot open the output file";
+		}
+
+		try
+		{
+			External_sort<T_Record>(input, output, predicate, options);
+		}
+		catch (...)
+		{
+			fclose(input);
+			fclose(output);
+			throw;
+		}
+
+		fclose(input);
+		if (fclose(output) != 0) throw "external sort write error";
+	}
+}
+
+#endif // !DVTL_EXTERNAL_SORT_H
@@ -0,0 +1,371 @@
+#ifndef DVTL_FLAT_MAP_H
+#define DVTL_FLAT_MAP_H
+
+#include "Algorithm.h"
+#include "Static_sorted_table.h"
+
+namespace DVTL
+{
+	namespace Detail
+	{
+		//sorts and drops repeated keys, of equal keys the one that comes first in values is kept;
+		//input that is already sorted costs one pass
+		template<typename T, typename T_Less>
+		inline void flatSortUnique(Vector<T>& values, T_Less less)
+		{
+			T* first = values.Data();
+			size_t size = values.Size();
+			if (size == 0) return;
+
+			if (Is_sorted(first, first + size, less)) {
+				T* end = Unique(first, first + size, less);
+				if (end != first + size) values.Erase(typename Vector<T>::const_iterator(end), values.CEnd());
+				return;
+			}
+
+			//Sort is not stable, so positions are sorted with the position breaking ties
+			//and the entries are moved once into their final order
+			Vector<size_t> order;
+			order.Reserve(size);
+			for (size_t i = 0; i < size; ++i)
+				order.Push_back(i);
+
+			Sort(order.Data(), order.Data() + size, [first, &less](size_t left, size_t right) {
+				return less(first[left], first[right]) || (!less(first[right], first[left]) && left < right); });
+
+			Vector<T> sorted;
+			sorted.Reserve(size);
+			for (size_t i = 0; i < size; ++i)
+				if (sorted.Empty() || less(sorted[sorted.Size() - 1], first[order[i]]))
+					sorted.Push_back(Move(first[order[i]]));
+
+			values.Swap(sorted);
+		}
+
+		//merges a sorted batch without repeated keys in one pass, entries already in values win;
+		//a batch past the last entry is appended in place
+		template<typename T, typename T_Less>
+		inline void flatMerge(Vector<T>& values, Vector<T>& batch, T_Less less)
+		{
+			size_t size = values.Size();
+			size_t count = batch.Size();
+			if (count == 0) return;
+
+			if (size == 0 || less(values[size - 1], batch[0])) {
+				values.Reserve(size + count);
+				for (size_t i = 0; i < count; ++i)
+					values.Push_back(Move(batch[i]));
+				return;
+			}
+
+			Vector<T> merged;
+			merged.Reserve(size + count);
+			size_t left = 0;
+			size_t right = 0;
+
+			while (left < size && right < count) {
+				if (less(batch[right], values[left]))
+					merged.Push_back(Move(batch[right++]));
+				else {
+					if (!less(values[left], batch[right])) ++right;
+					merged.Push_back(Move(values[left++]));
+				}
+			}
+			for (; left < size; ++left)
+				merged.Push_back(Move(values[left]));
+			for (; right < count; ++right)
+				merged.Push_back(Move(batch[right]));
+
+			values.Swap(merged);
+		}
+	}
+
+	//map kept as one sorted Vector of entries, for tables that are built once and read many times:
+	//lookups are a binary search over contiguous memory and there is no per-entry allocation;
+	//inserting or erasing one entry shifts the entries after it, so bulk changes go through
+	//the constructors and the range Insert, which sort the new entries and merge them in one pass;
+	//any insert or erase invalidates iterators and references
+	template<typename T_Key, typename T_Value, typename T_Compare = Less_than<T_Key>>
+	class Flat_map
+	{
+	public:
+		typedef typename Vector<Pair<T_Key, T_Value>>::iterator iterator;
+		typedef typename Vector<Pair<T_Key, T_Value>>::const_iterator const_iterator;
+
+		//constructors, of entries with repeated keys the first one is kept, as with repeated Insert calls
+		Flat_map() :m_entries(), m_compare() {}
+		explicit Flat_map(const T_Compare& compare) :m_entries(), m_compare(compare) {}
+		explicit Flat_map(Vector<Pair<T_Key, T_Value>>&& entries, const T_Compare& compare = T_Compare());
+		template<typename T_Iterator> Flat_map(T_Iterator first, T_Iterator last, const T_Compare& compare = T_Compare());
+		Flat_map(Initializer_list<Pair<T_Key, T_Value>> init_list, const T_Compare& compare = T_Compare());
+
+		//references to Flat_map elements
+		T_Value& At(const T_Key& key);
+		T_Value& operator[](const T_Key& key);
+		const T_Value& At(const T_Key& key) const;
+		const T_Value& operator[](const T_Key& key) const;
+
+		iterator Find(const T_Key& key);
+		const_iterator Find(const T_Key& key) const;
+		iterator Lower_bound(const T_Key& key)				{ return iterator(m_entries.Data() + lowerIndex(key)); }
+		const_iterator Lower_bound(const T_Key& key) const	{ return const_iterator(m_entries.Data() + lowerIndex(key)); }
+		iterator Upper_bound(const T_Key& key)				{ return iterator(m_entries.Data() + upperIndex(key)); }
+		const_iterator Upper_bound(const T_Key& key) const	{ return const_iterator(m_entries.Data() + upperIndex(key)); }
+
+		//working with data
+		inline size_t Size() const noexcept { return m_entries.Size(); }
+		inline bool Empty() const noexcept { return m_entries.Empty(); }
+		inline size_t Capacity() const noexcept { return m_entries.Capacity(); }
+		inline const Pair<T_Key, T_Value>* Data() const noexcept { return m_entries.Data(); }
+		bool Contains(const T_Key& key) const;
+		void Reserve(size_t count) { m_entries.Reserve(count); }
+		void Shrink_to_fit() { m_entries.Shrink_to_fit(); }
+		void Clear() { m_entries.Clear(); }
+		void Swap(Flat_map& right);
+
+		//adding and removing elements,
+		//inserting functions leave an existing element untouched and return it with false
+		iterator Erase(const T_Key& key);
+		Pair<iterator, bool> Insert(Pair<T_Key, T_Value>&& pair);
+		Pair<iterator, bool> Insert(const Pair<T_Key, T_Value>& pair);
+		Pair<iterator, bool> Insert(const T_Key& key, const T_Value& val);
+		template<typename T_Iterator> void Insert(T_Iterator first, T_Iterator last);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(const T_Key& key, T_Arg&& val);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(T_Key&& key, T_Arg&& val);
+		template<class... Types> Pair<iterator, bool> Emplace(Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(const T_Key& key, Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(T_Key&& key, Types&&... args);
+
+		//getting iterators begin and end
+		iterator Begin()	{ return m_entries.Begin(); }
+		iterator End()		{ return m_entries.End(); }
+		const_iterator Begin()	const { return m_entries.CBegin(); }
+		const_iterator End()	const { return m_entries.CEnd(); }
+		const_iterator CBegin() const { return m_entries.CBegin(); }
+		const_iterator CEnd()	const { return m_entries.CEnd(); }
+	private:
+		typedef Pair<T_Key, T_Value> Value_type;
+		typedef Detail::Entry_compare<T_Key, T_Value, T_Compare> Value_compare;
+
+		Vector<Value_type> m_entries;
+		T_Compare m_compare;
+
+		size_t lowerIndex(const T_Key& key) const;
+		size_t upperIndex(const T_Key& key) const;
+		bool found(size_t index, const T_Key& key) const { return index < m_entries.Size() && !m_compare(key, m_entries[index].First); }
+		iterator insertAt(size_t index, Value_type&& value);
+	};
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline Flat_map<T_Key, T_Value, T_Compare>::Flat_map(Vector<Pair<T_Key, T_Value>>&& entries, const T_Compare& compare)
+		:m_entries(Move(entries)), m_compare(compare)
+	{
+		Detail::flatSortUnique(m_entries, Value_compare{ m_compare });
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	template<typename T_Iterator>
+	inline Flat_map<T_Key, T_Value, T_Compare>::Flat_map(T_Iterator first, T_Iterator last, const T_Compare& compare)
+		:m_entries(), m_compare(compare)
+	{
+		for (; first != last; ++first)
+			m_entries.Push_back(*first);
+		Detail::flatSortUnique(m_entries, Value_compare{ m_compare });
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline Flat_map<T_Key, T_Value, T_Compare>::Flat_map(Initializer_list<Pair<T_Key, T_Value>> init_list, const T_Compare& compare)
+		:Flat_map(init_list.Begin(), init_list.End(), compare) {}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline T_Value& Flat_map<T_Key, T_Value, T_Compare>::At(const T_Key& key)
+	{
+		size_t index = lowerIndex(key);
+		if (!found(index, key)) throw "out of range flat map";
+		return m_entries[index].Second;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline T_Value& Flat_map<T_Key, T_Value, T_Compare>::operator[](const T_Key& key)
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline const T_Value& Flat_map<T_Key, T_Value, T_Compare>::At(const T_Key& key) const
+	{
+		size_t index = lowerIndex(key);
+		if (!found(index, key)) throw "out of range flat map";
+		return m_entries[index].Second;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline const T_Value& Flat_map<T_Key, T_Value, T_Compare>::operator[](const T_Key& key) const
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline typename Flat_map<T_Key, T_Value, T_Compare>::iterator Flat_map<T_Key, T_Value, T_Compare>::Find(const T_Key& key)
+	{
+		size_t index = lowerIndex(key);
+		return found(index, key) ? iterator(m_entries.Data() + index) : End();
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline typename Flat_map<T_Key, T_Value, T_Compare>::const_iterator Flat_map<T_Key, T_Value, T_Compare>::Find(const T_Key& key) const
+	{
+		size_t index = lowerIndex(key);
+		return found(index, key) ? const_iterator(m_entries.Data() + index) : End();
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline bool Flat_map<T_Key, T_Value, T_Compare>::Contains(const T_Key& key) const
+	{
+		return found(lowerIndex(key), key);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline void Flat_map<T_Key, T_Value, T_Compare>::Swap(Flat_map& right)
+	{
+		m_entries.Swap(right.m_entries);
+		DVTL::Swap(m_compare, right.m_compare);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline typename Flat_map<T_Key, T_Value, T_Compare>::iterator Flat_map<T_Key, T_Value, T_Compare>::Erase(const T_Key& key)
+	{
+		size_t index = lowerIndex(key);
+		if (!found(index, key)) return End();
+		return m_entries.Erase(const_iterator(m_entries.Data() + index));
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Insert(Pair<T_Key, T_Value>&& pair)
+	{
+		size_t index = lowerIndex(pair.First);
+		if (found(index, pair.First)) return Pair<iterator, bool>(iterator(m_entries.Data() + index), false);
+
+		return Pair<iterator, bool>(insertAt(index, Move(pair)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Insert(const Pair<T_Key, T_Value>& pair)
+	{
+		size_t index = lowerIndex(pair.First);
+		if (found(index, pair.First)) return Pair<iterator, bool>(iterator(m_entries.Data() + index), false);
+
+		return Pair<iterator, bool>(insertAt(index, Value_type(pair)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Insert(const T_Key& key, const T_Value& val)
+	{
+		return Try_emplace(key, val);
+	}
+
+	//the range is sorted on its own and merged in one pass instead of shifting the entries once per element;
+	//as with repeated Insert calls, existing entries win and of repeated keys in the range the first is kept
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	template<typename T_Iterator>
+	inline void Flat_map<T_Key, T_Value, T_Compare>::Insert(T_Iterator first, T_Iterator last)
+	{
+		Vector<Value_type> batch;
+		for (; first != last; ++first)
+			batch.Push_back(*first);
+
+		Detail::flatSortUnique(batch, Value_compare{ m_compare });
+		Detail::flatMerge(m_entries, batch, Value_compare{ m_compare });
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	template<typename T_Arg>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Insert_or_assign(const T_Key& key, T_Arg&& val)
+	{
+		size_t index = lowerIndex(key);
+		if (found(index, key)) {
+			m_entries[index].Second = Forward<T_Arg>(val);
+			return Pair<iterator, bool>(iterator(m_entries.Data() + index), false);
+		}
+
+		return Pair<iterator, bool>(insertAt(index, Value_type(key, Forward<T_Arg>(val))), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	template<typename T_Arg>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Insert_or_assign(T_Key&& key, T_Arg&& val)
+	{
+		size_t index = lowerIndex(key);
+		if (found(index, key)) {
+			m_entries[index].Second = Forward<T_Arg>(val);
+			return Pair<iterator, bool>(iterator(m_entries.Data() + index), false);
+		}
+
+		return Pair<iterator, bool>(insertAt(index, Value_type(Move(key), Forward<T_Arg>(val))), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	template<class... Types>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Emplace(Types&&... args)
+	{
+		//the key is only known once the element is built
+		Value_type value(Forward<Types>(args)...);
+		size_t index = lowerIndex(value.First);
+		if (found(index, value.First)) return Pair<iterator, bool>(iterator(m_entries.Data() + index), false);
+
+		return Pair<iterator, bool>(insertAt(index, Move(value)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	template<class... Types>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Try_emplace(const T_Key& key, Types&&... args)
+	{
+		size_t index = lowerIndex(key);
+		if (found(index, key)) return Pair<iterator, bool>(iterator(m_entries.Data() + index), false);
+
+		return Pair<iterator, bool>(insertAt(index, Value_type(In_place, key, Forward<Types>(args)...)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	template<class... Types>
+	inline Pair<typename Flat_map<T_Key, T_Value, T_Compare>::iterator, bool> Flat_map<T_Key, T_Value, T_Compare>::Try_emplace(T_Key&& key, Types&&... args)
+	{
+		size_t index = lowerIndex(key);
+		if (found(index, key)) return Pair<iterator, bool>(iterator(m_entries.Data() + index), false);
+
+		return Pair<iterator, bool>(insertAt(index, Value_type(In_place, Move(key), Forward<Types>(args)...)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline size_t Flat_map<T_Key, T_Value, T_Compare>::lowerIndex(const T_Key& key) const
+	{
+		const Value_type* first = m_entries.Data();
+		const T_Compare& compare = m_compare;
+		return DVTL::Lower_bound(first, first + m_entries.Size(), key,
+			[&compare](const Value_type& entry, const T_Key& value) { return compare(entry.First, value); }) - first;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline size_t Flat_map<T_Key, T_Value, T_Compare>::upperIndex(const T_Key& key) const
+	{
+		const Value_type* first = m_entries.Data();
+		const T_Compare& compare = m_compare;
+		return DVTL::Upper_bound(first, first + m_entries.Size(), key,
+			[&compare](const T_Key& value, const Value_type& entry) { return compare(value, entry.First); }) - first;
+	}
+
+	//the element is built by the caller, so arguments referring to entries of this map survive the shift
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline typename Flat_map<T_Key, T_Value, T_Compare>::iterator Flat_map<T_Key, T_Value, T_Compare>::insertAt(size_t index, Value_type&& value)
+	{
+		return m_entries.Inset(const_iterator(m_entries.Data() + index), Move(value));
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Compare>
+	inline void Swap(Flat_map<T_Key, T_Value, T_Compare>& left, Flat_map<T_Key, T_Value, T_Compare>& right)
+	{
+		left.Swap(right);
+	}
+}
+
+#endif // !DVTL_FLAT_MAP_H
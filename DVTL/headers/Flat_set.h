@@ -0,0 +1,163 @@
+#ifndef DVTL_FLAT_SET_H
+#define DVTL_FLAT_SET_H
+
+#include "Flat_map.h"
+
+namespace DVTL
+{
+	//set kept as one sorted Vector of keys, the key-only counterpart of Flat_map;
+	//keys are read-only through the iterators so the order cannot be broken
+	template<typename T_Key, typename T_Compare = Less_than<T_Key>>
+	class Flat_set
+	{
+	public:
+		typedef typename Vector<T_Key>::const_iterator iterator;
+		typedef typename Vector<T_Key>::const_iterator const_iterator;
+
+		//constructors, of repeated keys the first one is kept
+		Flat_set() :m_keys(), m_compare() {}
+		explicit Flat_set(const T_Compare& compare) :m_keys(), m_compare(compare) {}
+		explicit Flat_set(Vector<T_Key>&& keys, const T_Compare& compare = T_Compare());
+		template<typename T_Iterator> Flat_set(T_Iterator first, T_Iterator last, const T_Compare& compare = T_Compare());
+		Flat_set(Initializer_list<T_Key> init_list, const T_Compare& compare = T_Compare());
+
+		//lookups
+		const_iterator Find(const T_Key& key) const;
+		const_iterator Lower_bound(const T_Key& key) const { return const_iterator(m_keys.Data() + lowerIndex(key)); }
+		const_iterator Upper_bound(const T_Key& key) const { return const_iterator(m_keys.Data() + upperIndex(key)); }
+		bool Contains(const T_Key& key) const;
+
+		//working with data
+		inline size_t Size() const noexcept { return m_keys.Size(); }
+		inline bool Empty() const noexcept { return m_keys.Empty(); }
+		inline size_t Capacity() const noexcept { return m_keys.Capacity(); }
+		inline const T_Key* Data() const noexcept { return m_keys.Data(); }
+		void Reserve(size_t count) { m_keys.Reserve(count); }
+		void Shrink_to_fit() { m_keys.Shrink_to_fit(); }
+		void Clear() { m_keys.Clear(); }
+		void Swap(Flat_set& right);
+
+		//adding and removing elements,
+		//inserting functions leave an existing key untouched and return it with false
+		iterator Erase(const T_Key& key);
+		Pair<iterator, bool> Insert(const T_Key& key);
+		Pair<iterator, bool> Insert(T_Key&& key);
+		template<typename T_Iterator> void Insert(T_Iterator first, T_Iterator last);
+		template<class... Types> Pair<iterator, bool> Emplace(Types&&... args);
+
+		//getting iterators begin and end
+		const_iterator Begin()	const { return m_keys.CBegin(); }
+		const_iterator End()	const { return m_keys.CEnd(); }
+		const_iterator CBegin() const { return m_keys.CBegin(); }
+		const_iterator CEnd()	const { return m_keys.CEnd(); }
+	private:
+		Vector<T_Key> m_keys;
+		T_Compare m_compare;
+
+		size_t lowerIndex(const T_Key& key) const { return DVTL::Lower_bound(m_keys.Data(), m_keys.Data() + m_keys.Size(), key, m_compare) - m_keys.Data(); }
+		size_t upperIndex(const T_Key& key) const { return DVTL::Upper_bound(m_keys.Data(), m_keys.Data() + m_keys.Size(), key, m_compare) - m_keys.Data(); }
+		bool found(size_t index, const T_Key& key) const { return index < m_keys.Size() && !m_compare(key, m_keys[index]); }
+		Pair<iterator, bool> insertKey(T_Key&& key);
+	};
+
+	template<typename T_Key, typename T_Compare>
+	inline Flat_set<T_Key, T_Compare>::Flat_set(Vector<T_Key>&& keys, const T_Compare& compare)
+		:m_keys(Move(keys)), m_compare(compare)
+	{
+		Detail::flatSortUnique(m_keys, m_compare);
+	}
+
+	template<typename T_Key, typename T_Compare>
+	template<typename T_Iterator>
+	inline Flat_set<T_Key, T_Compare>::Flat_set(T_Iterator first, T_Iterator last, const T_Compare& compare)
+		:m_keys(), m_compare(compare)
+	{
+		for (; first != last; ++first)
+			m_keys.Push_back(*first);
+		Detail::flatSortUnique(m_keys, m_compare);
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline Flat_set<T_Key, T_Compare>::Flat_set(Initializer_list<T_Key> init_list, const T_Compare& compare)
+		:Flat_set(init_list.Begin(), init_list.End(), compare) {}
+
+	template<typename T_Key, typename T_Compare>
+	inline typename Flat_set<T_Key, T_Compare>::const_iterator Flat_set<T_Key, T_Compare>::Find(const T_Key& key) const
+	{
+		size_t index = lowerIndex(key);
+		return found(index, key) ? const_iterator(m_keys.Data() + index) : End();
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline bool Flat_set<T_Key, T_Compare>::Contains(const T_Key& key) const
+	{
+		return found(lowerIndex(key), key);
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline void Flat_set<T_Key, T_Compare>::Swap(Flat_set& right)
+	{
+		m_keys.Swap(right.m_keys);
+		DVTL::Swap(m_compare, right.m_compare);
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline typename Flat_set<T_Key, T_Compare>::iterator Flat_set<T_Key, T_Compare>::Erase(const T_Key& key)
+	{
+		size_t index = lowerIndex(key);
+		if (!found(index, key)) return End();
+		return m_keys.Erase(const_iterator(m_keys.Data() + index));
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline Pair<typename Flat_set<T_Key, T_Compare>::iterator, bool> Flat_set<T_Key, T_Compare>::Insert(const T_Key& key)
+	{
+		size_t index = lowerIndex(key);
+		if (found(index, key)) return Pair<iterator, bool>(const_iterator(m_keys.Data() + index), false);
+
+		return Pair<iterator, bool>(m_keys.Inset(const_iterator(m_keys.Data() + index), T_Key(key)), true);
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline Pair<typename Flat_set<T_Key, T_Compare>::iterator, bool> Flat_set<T_Key, T_Compare>::Insert(T_Key&& key)
+	{
+		return insertKey(Move(key));
+	}
+
+	//the range is sorted on its own and merged in one pass instead of shifting the keys once per element
+	template<typename T_Key, typename T_Compare>
+	template<typename T_Iterator>
+	inline void Flat_set<T_Key, T_Compare>::Insert(T_Iterator first, T_Iterator last)
+	{
+		Vector<T_Key> batch;
+		for (; first != last; ++first)
+			batch.Push_back(*first);
+
+		Detail::flatSortUnique(batch, m_compare);
+		Detail::flatMerge(m_keys, batch, m_compare);
+	}
+
+	template<typename T_Key, typename T_Compare>
+	template<class... Types>
+	inline Pair<typename Flat_set<T_Key, T_Compare>::iterator, bool> Flat_set<T_Key, T_Compare>::Emplace(Types&&... args)
+	{
+		return insertKey(T_Key(Forward<Types>(args)...));
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline Pair<typename Flat_set<T_Key, T_Compare>::iterator, bool> Flat_set<T_Key, T_Compare>::insertKey(T_Key&& key)
+	{
+		size_t index = lowerIndex(key);
+		if (found(index, key)) return Pair<iterator, bool>(const_iterator(m_keys.Data() + index), false);
+
+		return Pair<iterator, bool>(m_keys.Inset(const_iterator(m_keys.Data() + index), Move(key)), true);
+	}
+
+	template<typename T_Key, typename T_Compare>
+	inline void Swap(Flat_set<T_Key, T_Compare>& left, Flat_set<T_Key, T_Compare>& right)
+	{
+		left.Swap(right);
+	}
+}
+
+#endif // !DVTL_FLAT_SET_H
@@ -0,0 +1,222 @@
+#ifndef DVTL_HASH_H
+#define DVTL_HASH_H
+
+#include "Utility.h"
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace DVTL
+{
+	namespace Detail
+	{
+		//murmur3 64-bit finalizer, every input bit affects every output bit
+		constexpr unsigned long long mixHash(unsigned long long value)
+		{
+			value ^= value >> 33;
+			value *= 0xFF51AFD7ED558CCDull;
+			value ^= value >> 33;
+			value *= 0xC4CEB9FE1A85EC53ull;
+			value ^= value >> 33;
+			return value;
+		}
+
+		//full 128-bit product, returns the high half
+		inline unsigned long long multiplyWide(unsigned long long left, unsigned long long right, unsigned long long& low)
+		{
+#if defined(__SIZEOF_INT128__)
+			unsigned __int128 product = static_cast<unsigned __int128>(left) * right;
+			low = static_cast<unsigned long long>(product);
+			return static_cast<unsigned long long>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+			unsigned long long high;
+			low = _umul128(left, right, &high);
+			return high;
+#else
+			unsigned long long leftLow = left & 0xFFFFFFFFull, leftHigh = left >> 32;
+			unsigned long long rightLow = right & 0xFFFFFFFFull, rightHigh = right >> 32;
+			unsigned long long lowLow = leftLow * rightLow;
+			unsigned long long middle = leftHigh * rightLow + (lowLow >> 32);
+			unsigned long long cross = leftLow * rightHigh + (middle & 0xFFFFFFFFull);
+
+			low = (cross << 32) | (lowLow & 0xFFFFFFFFull);
+			return leftHigh * rightHigh + (middle >> 32) + (cross >> 32);
+#endif
+		}
+
+		//wyhash constants
+		constexpr unsigned long long hashSecret[4] = { 0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull, 0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull };
+
+		//wyhash mix: both halves of the 128-bit product folded together
+		inline unsigned long long mixWide(unsigned long long left, unsigned long long right)
+		{
+			unsigned long long low;
+			unsigned long long high = multiplyWide(left, right, low);
+			return low ^ high;
+		}
+
+		//one multiplication instead of the two of mixHash
+		inline unsigned long long mixFast(unsigned long long value)
+		{
+			return mixWide(value ^ hashSecret[0], hashSecret[1]);
+		}
+
+		//unaligned native order reads, compilers turn the loops into single loads
+		inline unsigned long long read64(const unsigned char* data)
+		{
+			unsigned long long value = 0;
+			unsigned char* target = reinterpret_cast<unsigned char*>(&value);
+			for (size_t i = 0; i < 8; ++i)
+				target[i] = data[i];
+			return value;
+		}
+
+		inline unsigned long long read32(const unsigned char* data)
+		{
+			unsigned int value = 0;
+			unsigned char* target = reinterpret_cast<unsigned char*>(&value);
+			for (size_t i = 0; i < 4; ++i)
+				target[i] = data[i];
+			return value;
+		}
+
+		template<typename T> constexpr bool Is_character_v = false;
+		template<> constexpr bool Is_character_v<char> = true;
+		template<> constexpr bool Is_character_v<signed char> = true;
+		template<> constexpr bool Is_character_v<unsigned char> = true;
+		template<> constexpr bool Is_character_v<wchar_t> = true;
+		template<> constexpr bool Is_character_v<char16_t> = true;
+		template<> constexpr bool Is_character_v<char32_t> = true;
+
+		template<typename T>
+		using String_character_t = Remove_cvref_t<decltype(*Declval<const T&>().data())>;
+	}
+
+	//wyhash over size bytes: three independent multiply chains take 48 bytes per round,
+	//keys up to 16 bytes are read with at most four overlapping loads and no loop
+	inline size_t Hash_bytes(const void* data, size_t size, unsigned long long seed = 0)
+	{
+		using Detail::hashSecret;
+		using Detail::mixWide;
+		using Detail::read64;
+		using Detail::read32;
+
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		seed ^= mixWide(seed ^ hashSecret[0], hashSecret[1]);
+		unsigned long long first, second;
+
+		if (size <= 16) {
+			if (size >= 4) {
+				size_t offset = (size >> 3) << 2;
+				first = (read32(bytes) << 32) | read32(bytes + offset);
+				second = (read32(bytes + size - 4) << 32) | read32(bytes + size - 4 - offset);
+			}
+			else if (size > 0) {
+				first = (static_cast<unsigned long long>(bytes[0]) << 16) | (static_cast<unsigned long long>(bytes[size >> 1]) << 8) | bytes[size - 1];
+				second = 0;
+			}
+			else
+				first = second = 0;
+		}
+		else {
+			size_t left = size;
+			if (left > 48) {
+				unsigned long long lane1 = seed, lane2 = seed;
+				do {
+					seed = mixWide(read64(bytes) ^ hashSecret[1], read64(bytes + 8) ^ seed);
+					lane1 = mixWide(read64(bytes + 16) ^ hashSecret[2], read64(bytes + 24) ^ lane1);
+					lane2 = mixWide(read64(bytes + 32) ^ hashSecret[3], read64(bytes + 40) ^ lane2);
+					bytes += 48;
+					left -= 48;
+				} while (left > 48);
+				seed ^= lane1 ^ lane2;
+			}
+			while (left > 16) {
+				seed = mixWide(read64(bytes) ^ hashSecret[1], read64(bytes + 8) ^ seed);
+				bytes += 16;
+				left -= 16;
+			}
+			first = read64(bytes + left - 16);
+			second = read64(bytes + left - 8);
+		}
+
+		first ^= hashSecret[1];
+		second ^= seed;
+		second = Detail::multiplyWide(first, second, first);
+		return static_cast<size_t>(mixWide(first ^ hashSecret[0] ^ size, second ^ hashSecret[1]));
+	}
+
+	//order dependent, Hash_combine(a, b) and Hash_combine(b, a) differ
+	inline size_t Hash_combine(size_t seed, size_t hash)
+	{
+		return static_cast<size_t>(Detail::mixWide(seed ^ Detail::hashSecret[0], hash ^ Detail::hashSecret[1]));
+	}
+
+	//customization point used by the hash based algorithms and containers,
+	//specialize it for own key types; the primary template covers integers and enums
+	template<typename T, typename = void>
+	struct Hash
+	{
+		size_t operator()(const T& value) const { return static_cast<size_t>(Detail::mixFast(static_cast<unsigned long long>(value))); }
+	};
+
+	template<typename T>
+	struct Hash<T*>
+	{
+		size_t operator()(T* value) const { return static_cast<size_t>(Detail::mixFast(reinterpret_cast<unsigned long long>(value))); }
+	};
+
+	template<>
+	struct Hash<double>
+	{
+		size_t operator()(double value) const
+		{
+			//0.0 and -0.0 compare equal
+			if (value == 0) value = 0;
+
+			unsigned long long bits = 0;
+			const unsigned char* source = reinterpret_cast<const unsigned char*>(&value);
+			unsigned char* target = reinterpret_cast<unsigned char*>(&bits);
+			for (size_t i = 0; i < sizeof(double); ++i)
+				target[i] = source[i];
+
+			return static_cast<size_t>(Detail::mixFast(bits));
+		}
+	};
+
+	template<>
+	struct Hash<float>
+	{
+		size_t operator()(float value) const { return Hash<double>()(value); }
+	};
+
+	//contiguous character strings with data() and size(), such as std::string and std::string_view
+	template<typename T>
+	struct Hash<T, Enable_if_t<Detail::Is_character_v<Detail::String_character_t<T>>, Void_t<decltype(Declval<const T&>().size())>>>
+	{
+		size_t operator()(const T& value) const { return Hash_bytes(value.data(), value.size() * sizeof(Detail::String_character_t<T>)); }
+	};
+
+	template<typename T1, typename T2>
+	struct Hash<Pair<T1, T2>>
+	{
+		size_t operator()(const Pair<T1, T2>& value) const { return Hash_combine(Hash<T1>()(value.First), Hash<T2>()(value.Second)); }
+	};
+
+	//hash of several fields in order, for the Hash specialization of an aggregate:
+	//return Hash_values(point.x, point.y);
+	template<typename T>
+	inline size_t Hash_values(const T& value)
+	{
+		return Hash<T>()(value);
+	}
+
+	template<typename T, typename... Types>
+	inline size_t Hash_values(const T& value, const Types&... values)
+	{
+		return Hash_combine(Hash<T>()(value), Hash_values(values...));
+	}
+}
+
+#endif // !DVTL_HASH_H
@@ -0,0 +1,642 @@
+#ifndef DVTL_HASH_MAP_H
+#define DVTL_HASH_MAP_H
+
+#include "Algorithm.h"
+#include "Allocator.h"
+#include "Hash.h"
+#include "Initializer_list.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DVTL_HASH_MAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define DVTL_HASH_MAP_SSE2 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace DVTL
+{
+	namespace Detail
+	{
+		//control bytes of sixteen consecutive slots, matched at once:
+		//an empty slot holds -128 and a full one the low seven bits of its hash
+		class Control_group
+		{
+		public:
+			static constexpr size_t width = 16;
+			static constexpr signed char empty = -128;
+
+#if DVTL_HASH_MAP_SSE2
+			explicit Control_group(const signed char* control) :m_bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))) {}
+
+			//bit i is set when slot i matches
+			unsigned int Match(signed char fragment) const { return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(fragment), m_bytes))); }
+			unsigned int Match_empty() const { return static_cast<unsigned int>(_mm_movemask_epi8(m_bytes)); }
+		private:
+			__m128i m_bytes;
+#else
+			explicit Control_group(const signed char* control) :m_bytes(control) {}
+
+			unsigned int Match(signed char fragment) const
+			{
+				unsigned int mask = 0;
+				for (size_t i = 0; i < width; ++i)
+					mask |= static_cast<unsigned int>(m_bytes[i] == fragment) << i;
+				return mask;
+			}
+			unsigned int Match_empty() const { return Match(empty); }
+		private:
+			const signed char* m_bytes;
+#endif
+		public:
+			unsigned int Match_full() const { return Match_empty() ^ 0xFFFFu; }
+		};
+
+		//index of the lowest set bit, mask must not be zero
+		inline unsigned int lowestBit(unsigned int mask)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned int>(__builtin_ctz(mask));
+#elif defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return static_cast<unsigned int>(index);
+#else
+			unsigned int index = 0;
+			while ((mask & 1u) == 0) {
+				mask >>= 1;
+				++index;
+			}
+			return index;
+#endif
+		}
+	}
+
+	//unordered map with open addressing in the style of SwissTable: a byte of hash per slot is compared
+	//for sixteen slots at once, so a lookup rarely calls the equality on a key that does not match;
+	//probing is linear and erasing shifts the following entries back, there are no tombstones to clean up;
+	//at most 7/8 of the slots are used, growing doubles the table and invalidates iterators and references,
+	//erasing invalidates them as well
+	template<typename T_Key, typename T_Value, typename T_Hash = Hash<T_Key>, typename T_Equal = Equal_to<T_Key>>
+	class Hash_map
+	{
+	public:
+		//declaring iterators
+		class iterator;
+		class const_iterator;
+
+		//constructors, operators= and destructor
+		Hash_map() noexcept;
+		explicit Hash_map(size_t count, const T_Hash& hash = T_Hash(), const T_Equal& equal = T_Equal());
+		Hash_map(const Hash_map& right);
+		Hash_map(Hash_map&& right) noexcept;
+		Hash_map(Initializer_list<Pair<T_Key, T_Value>> init_list);
+
+		Hash_map& operator=(const Hash_map& right);
+		Hash_map& operator=(Hash_map&& right) noexcept;
+
+		~Hash_map();
+
+		//references to Hash_map elements
+		T_Value& At(const T_Key& key);
+		T_Value& operator[](const T_Key& key);
+		const T_Value& At(const T_Key& key) const;
+		const T_Value& operator[](const T_Key& key) const;
+
+		iterator Find(const T_Key& key);
+		const_iterator Find(const T_Key& key) const;
+
+		//working with data
+		void Clear();
+		void Reserve(size_t count);
+		inline bool Empty() const noexcept { return m_size == 0; }
+		inline size_t Size() const noexcept { return m_size; }
+		inline size_t Capacity() const noexcept { return m_capacity; }
+		bool Contains(const T_Key& key) const;
+		void Swap(Hash_map& right) noexcept;
+
+		//adding and removing elements,
+		//inserting functions leave an existing element untouched and return it with false;
+		//Erase returns whether the key was there, the order of the other elements may change
+		bool Erase(const T_Key& key);
+		Pair<iterator, bool> Insert(Pair<T_Key, T_Value>&& pair);
+		Pair<iterator, bool> Insert(const Pair<T_Key, T_Value>& pair);
+		Pair<iterator, bool> Insert(const T_Key& key, const T_Value& val);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(const T_Key& key, T_Arg&& val);
+		template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(T_Key&& key, T_Arg&& val);
+		template<class... Types> Pair<iterator, bool> Emplace(Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(const T_Key& key, Types&&... args);
+		template<class... Types> Pair<iterator, bool> Try_emplace(T_Key&& key, Types&&... args);
+
+		//getting iterators begin and end, elements come in slot order
+		iterator Begin()	{ return iterator(this, nextFull(0)); }
+		iterator End()		{ return iterator(this, m_capacity); }
+		const_iterator Begin()	const { return const_iterator(this, nextFull(0)); }
+		const_iterator End()	const { return const_iterator(this, m_capacity); }
+		const_iterator CBegin() const { return const_iterator(this, nextFull(0)); }
+		const_iterator CEnd()	const { return const_iterator(this, m_capacity); }
+	private:
+		typedef Pair<T_Key, T_Value> Value_type;
+		typedef Detail::Control_group Group;
+
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		signed char* m_control;		//capacity bytes and a copy of the first group width - 1 bytes, so groups never wrap
+		Value_type* m_slots;
+		size_t m_capacity;			//zero or a power of two not less than the group width
+		size_t m_size;
+		unsigned int m_shift;		//64 minus log2 of the capacity
+		T_Hash m_hash;
+		T_Equal m_equal;
+
+		//Fibonacci hashing takes the home slot from the high bits and leaves the low bits for the control byte
+		size_t homeSlot(size_t hash) const { return static_cast<size_t>((static_cast<unsigned long long>(hash) * 0x9E3779B97F4A7C15ull) >> m_shift); }
+		static signed char fragment(size_t hash) { return static_cast<signed char>(hash & 0x7F); }
+		static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+		void setControl(size_t index, signed char value);
+		size_t find(const T_Key& key, size_t hash, size_t& emptyIndex) const;
+		size_t findEmpty(size_t hash) const;
+		size_t nextFull(size_t index) const;
+		template<class... Types> iterator insertNew(size_t hash, size_t emptyIndex, Types&&... args);
+		void rehash(size_t capacity);
+		void allocate(size_t capacity);
+		void destroyAll();
+	};
+
+	//defining an iterator interface
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	class Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator
+	{
+	public:
+		//constructors
+		iterator(Hash_map* map, size_t index) :m_map(map), m_index(index) {}
+
+		//logical operators
+		bool operator==(const iterator& other) const { return m_index == other.m_index; }
+		bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+
+		//data access
+		Pair<T_Key, T_Value>& operator*() const { return m_map->m_slots[m_index]; }
+		Pair<T_Key, T_Value>* operator->() const { return m_map->m_slots + m_index; }
+
+		//mathematical operators
+		iterator& operator++() { m_index = m_map->nextFull(m_index + 1); return *this; }
+		iterator operator++(int) { iterator it(*this); m_index = m_map->nextFull(m_index + 1); return it; }
+
+		friend class Hash_map<T_Key, T_Value, T_Hash, T_Equal>;
+	private:
+		Hash_map* m_map;
+		size_t m_index;
+	};
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	class Hash_map<T_Key, T_Value, T_Hash, T_Equal>::const_iterator
+	{
+	public:
+		//constructors
+		const_iterator(const Hash_map* map, size_t index) :m_map(map), m_index(index) {}
+		const_iterator(const iterator& it) :m_map(it.m_map), m_index(it.m_index) {}
+
+		//logical operators
+		bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+		bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+		//data access
+		const Pair<T_Key, T_Value>& operator*() const { return m_map->m_slots[m_index]; }
+		const Pair<T_Key, T_Value>* operator->() const { return m_map->m_slots + m_index; }
+
+		//mathematical operators
+		const_iterator& operator++() { m_index = m_map->nextFull(m_index + 1); return *this; }
+		const_iterator operator++(int) { const_iterator it(*this); m_index = m_map->nextFull(m_index + 1); return it; }
+
+		friend class Hash_map<T_Key, T_Value, T_Hash, T_Equal>;
+	private:
+		const Hash_map* m_map;
+		size_t m_index;
+	};
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Hash_map() noexcept
+		:m_control(nullptr), m_slots(nullptr), m_capacity(0), m_size(0), m_shift(64), m_hash(), m_equal() {}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Hash_map(size_t count, const T_Hash& hash, const T_Equal& equal)
+		:m_control(nullptr), m_slots(nullptr), m_capacity(0), m_size(0), m_shift(64), m_hash(hash), m_equal(equal)
+	{
+		Reserve(count);
+	}
+
+	//slots keep their positions, so the copy needs no hashing
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Hash_map(const Hash_map& right)
+		:m_control(nullptr), m_slots(nullptr), m_capacity(0), m_size(0), m_shift(64), m_hash(right.m_hash), m_equal(right.m_equal)
+	{
+		if (right.m_size == 0) return;
+
+		allocate(right.m_capacity);
+		for (size_t i = 0; i < m_capacity; ++i) {
+			if (right.m_control[i] == Group::empty) continue;
+			Allocator::Construct(m_slots + i, right.m_slots[i]);
+			setControl(i, right.m_control[i]);
+			++m_size;
+		}
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Hash_map(Hash_map&& right) noexcept :Hash_map()
+	{
+		Swap(right);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Hash_map(Initializer_list<Pair<T_Key, T_Value>> init_list) :Hash_map()
+	{
+		Reserve(init_list.Size());
+		for (size_t i = 0; i < init_list.Size(); ++i)
+			Insert(*(init_list.Begin() + i));
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>& Hash_map<T_Key, T_Value, T_Hash, T_Equal>::operator=(const Hash_map& right)
+	{
+		if (this == &right) return *this;
+
+		Hash_map copy(right);
+		Swap(copy);
+		return *this;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>& Hash_map<T_Key, T_Value, T_Hash, T_Equal>::operator=(Hash_map&& right) noexcept
+	{
+		if (this == &right) return *this;
+
+		destroyAll();
+		Swap(right);
+		return *this;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Hash_map<T_Key, T_Value, T_Hash, T_Equal>::~Hash_map()
+	{
+		destroyAll();
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline T_Value& Hash_map<T_Key, T_Value, T_Hash, T_Equal>::At(const T_Key& key)
+	{
+		size_t emptyIndex;
+		size_t index = find(key, m_hash(key), emptyIndex);
+		if (index == npos) throw "out of range hash map";
+		return m_slots[index].Second;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline T_Value& Hash_map<T_Key, T_Value, T_Hash, T_Equal>::operator[](const T_Key& key)
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline const T_Value& Hash_map<T_Key, T_Value, T_Hash, T_Equal>::At(const T_Key& key) const
+	{
+		size_t emptyIndex;
+		size_t index = find(key, m_hash(key), emptyIndex);
+		if (index == npos) throw "out of range hash map";
+		return m_slots[index].Second;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline const T_Value& Hash_map<T_Key, T_Value, T_Hash, T_Equal>::operator[](const T_Key& key) const
+	{
+		return At(key);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Find(const T_Key& key)
+	{
+		size_t emptyIndex;
+		size_t index = find(key, m_hash(key), emptyIndex);
+		return index == npos ? End() : iterator(this, index);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::const_iterator Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Find(const T_Key& key) const
+	{
+		size_t emptyIndex;
+		size_t index = find(key, m_hash(key), emptyIndex);
+		return index == npos ? End() : const_iterator(this, index);
+	}
+
+	//destroys the elements and keeps the table
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Clear()
+	{
+		if (m_size == 0) return;
+
+		for (size_t i = 0; i < m_capacity; ++i) {
+			if (m_control[i] == Group::empty) continue;
+			if (!Is_trivially_destructible_v<Value_type>) Allocator::Destroy(m_slots + i);
+		}
+		for (size_t i = 0; i < m_capacity + Group::width - 1; ++i)
+			m_control[i] = Group::empty;
+
+		m_size = 0;
+	}
+
+	//makes room for count elements without growing
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Reserve(size_t count)
+	{
+		size_t capacity = Group::width;
+		while (maxLoad(capacity) < count)
+			capacity *= 2;
+
+		if (capacity > m_capacity) rehash(capacity);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline bool Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Contains(const T_Key& key) const
+	{
+		size_t emptyIndex;
+		return find(key, m_hash(key), emptyIndex) != npos;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Swap(Hash_map& right) noexcept
+	{
+		DVTL::Swap(m_control, right.m_control);
+		DVTL::Swap(m_slots, right.m_slots);
+		DVTL::Swap(m_capacity, right.m_capacity);
+		DVTL::Swap(m_size, right.m_size);
+		DVTL::Swap(m_shift, right.m_shift);
+		DVTL::Swap(m_hash, right.m_hash);
+		DVTL::Swap(m_equal, right.m_equal);
+	}
+
+	//backward shift: every following element of the probe run moves into the hole
+	//unless its home slot lies between the hole and itself
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline bool Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Erase(const T_Key& key)
+	{
+		size_t emptyIndex;
+		size_t hole = find(key, m_hash(key), emptyIndex);
+		if (hole == npos) return false;
+
+		Allocator::Destroy(m_slots + hole);
+		--m_size;
+
+		size_t mask = m_capacity - 1;
+		for (size_t index = (hole + 1) & mask; m_control[index] != Group::empty; index = (index + 1) & mask) {
+			size_t home = homeSlot(m_hash(m_slots[index].First));
+			bool stays = hole <= index ? hole < home && home <= index : hole < home || home <= index;
+			if (stays) continue;
+
+			Allocator::Construct(m_slots + hole, Move(m_slots[index]));
+			Allocator::Destroy(m_slots + index);
+			setControl(hole, m_control[index]);
+			hole = index;
+		}
+
+		setControl(hole, Group::empty);
+		return true;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Insert(Pair<T_Key, T_Value>&& pair)
+	{
+		size_t hash = m_hash(pair.First);
+		size_t emptyIndex;
+		size_t index = find(pair.First, hash, emptyIndex);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(insertNew(hash, emptyIndex, Move(pair)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Insert(const Pair<T_Key, T_Value>& pair)
+	{
+		size_t hash = m_hash(pair.First);
+		size_t emptyIndex;
+		size_t index = find(pair.First, hash, emptyIndex);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(insertNew(hash, emptyIndex, pair), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Insert(const T_Key& key, const T_Value& val)
+	{
+		return Try_emplace(key, val);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	template<typename T_Arg>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Insert_or_assign(const T_Key& key, T_Arg&& val)
+	{
+		size_t hash = m_hash(key);
+		size_t emptyIndex;
+		size_t index = find(key, hash, emptyIndex);
+		if (index != npos) {
+			m_slots[index].Second = Forward<T_Arg>(val);
+			return Pair<iterator, bool>(iterator(this, index), false);
+		}
+
+		return Pair<iterator, bool>(insertNew(hash, emptyIndex, In_place, key, Forward<T_Arg>(val)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	template<typename T_Arg>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Insert_or_assign(T_Key&& key, T_Arg&& val)
+	{
+		size_t hash = m_hash(key);
+		size_t emptyIndex;
+		size_t index = find(key, hash, emptyIndex);
+		if (index != npos) {
+			m_slots[index].Second = Forward<T_Arg>(val);
+			return Pair<iterator, bool>(iterator(this, index), false);
+		}
+
+		return Pair<iterator, bool>(insertNew(hash, emptyIndex, In_place, Move(key), Forward<T_Arg>(val)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	template<class... Types>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Emplace(Types&&... args)
+	{
+		//the key is only known once the element is built
+		Value_type value(Forward<Types>(args)...);
+		size_t hash = m_hash(value.First);
+		size_t emptyIndex;
+		size_t index = find(value.First, hash, emptyIndex);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(insertNew(hash, emptyIndex, Move(value)), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	template<class... Types>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Try_emplace(const T_Key& key, Types&&... args)
+	{
+		size_t hash = m_hash(key);
+		size_t emptyIndex;
+		size_t index = find(key, hash, emptyIndex);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(insertNew(hash, emptyIndex, In_place, key, Forward<Types>(args)...), true);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	template<class... Types>
+	inline Pair<typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator, bool> Hash_map<T_Key, T_Value, T_Hash, T_Equal>::Try_emplace(T_Key&& key, Types&&... args)
+	{
+		size_t hash = m_hash(key);
+		size_t emptyIndex;
+		size_t index = find(key, hash, emptyIndex);
+		if (index != npos) return Pair<iterator, bool>(iterator(this, index), false);
+
+		return Pair<iterator, bool>(insertNew(hash, emptyIndex, In_place, Move(key), Forward<Types>(args)...), true);
+	}
+
+	//the first group width - 1 bytes are mirrored after the last slot
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Hash_map<T_Key, T_Value, T_Hash, T_Equal>::setControl(size_t index, signed char value)
+	{
+		m_control[index] = value;
+		if (index < Group::width - 1) m_control[m_capacity + index] = value;
+	}
+
+	//returns the slot of the key or npos and the first empty slot of its probe run
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline size_t Hash_map<T_Key, T_Value, T_Hash, T_Equal>::find(const T_Key& key, size_t hash, size_t& emptyIndex) const
+	{
+		emptyIndex = npos;
+		if (m_capacity == 0) return npos;
+
+		size_t mask = m_capacity - 1;
+		signed char wanted = fragment(hash);
+
+		for (size_t position = homeSlot(hash); ; position = (position + Group::width) & mask) {
+			Group group(m_control + position);
+
+			for (unsigned int match = group.Match(wanted); match != 0; match &= match - 1) {
+				size_t index = (position + Detail::lowestBit(match)) & mask;
+				if (m_equal(m_slots[index].First, key)) return index;
+			}
+
+			unsigned int empty = group.Match_empty();
+			if (empty != 0) {
+				emptyIndex = (position + Detail::lowestBit(empty)) & mask;
+				return npos;
+			}
+		}
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline size_t Hash_map<T_Key, T_Value, T_Hash, T_Equal>::findEmpty(size_t hash) const
+	{
+		size_t mask = m_capacity - 1;
+
+		for (size_t position = homeSlot(hash); ; position = (position + Group::width) & mask) {
+			unsigned int empty = Group(m_control + position).Match_empty();
+			if (empty != 0) return (position + Detail::lowestBit(empty)) & mask;
+		}
+	}
+
+	//first full slot at or after index, the capacity when there is none
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline size_t Hash_map<T_Key, T_Value, T_Hash, T_Equal>::nextFull(size_t index) const
+	{
+		for (; index < m_capacity; index += Group::width) {
+			unsigned int full = Group(m_control + index).Match_full();
+			if (full != 0) {
+				index += Detail::lowestBit(full);
+				return index < m_capacity ? index : m_capacity;
+			}
+		}
+
+		return m_capacity;
+	}
+
+	//when the table has to grow the element is built first, so arguments referring to elements of this map stay valid
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	template<class... Types>
+	inline typename Hash_map<T_Key, T_Value, T_Hash, T_Equal>::iterator Hash_map<T_Key, T_Value, T_Hash, T_Equal>::insertNew(size_t hash, size_t emptyIndex, Types&&... args)
+	{
+		if (m_size + 1 > maxLoad(m_capacity)) {
+			Value_type value(Forward<Types>(args)...);
+			rehash(m_capacity == 0 ? Group::width : m_capacity * 2);
+			emptyIndex = findEmpty(hash);
+			Allocator::Construct(m_slots + emptyIndex, Move(value));
+		}
+		else
+			new (m_slots + emptyIndex) Value_type(Forward<Types>(args)...);
+
+		setControl(emptyIndex, fragment(hash));
+		++m_size;
+		return iterator(this, emptyIndex);
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Hash_map<T_Key, T_Value, T_Hash, T_Equal>::rehash(size_t capacity)
+	{
+		signed char* control = m_control;
+		Value_type* slots = m_slots;
+		size_t oldCapacity = m_capacity;
+
+		allocate(capacity);
+
+		for (size_t i = 0; i < oldCapacity; ++i) {
+			if (control[i] == Group::empty) continue;
+
+			size_t hash = m_hash(slots[i].First);
+			size_t index = findEmpty(hash);
+			Allocator::Construct(m_slots + index, Move(slots[i]));
+			Allocator::Destroy(slots + i);
+			setControl(index, fragment(hash));
+		}
+
+		Allocator::Deallocate(control);
+		Allocator::Deallocate(slots);
+	}
+
+	//empty table of capacity slots, replaces the pointers without releasing them
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Hash_map<T_Key, T_Value, T_Hash, T_Equal>::allocate(size_t capacity)
+	{
+		m_control = Allocator::Allocate<signed char>(capacity + Group::width - 1);
+		m_slots = Allocator::Allocate<Value_type>(capacity);
+		m_capacity = capacity;
+
+		for (size_t i = 0; i < capacity + Group::width - 1; ++i)
+			m_control[i] = Group::empty;
+
+		m_shift = 64;
+		for (size_t size = capacity; size > 1; size >>= 1)
+			--m_shift;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Hash_map<T_Key, T_Value, T_Hash, T_Equal>::destroyAll()
+	{
+		Clear();
+		Allocator::Deallocate(m_control);
+		Allocator::Deallocate(m_slots);
+		m_control = nullptr;
+		m_slots = nullptr;
+		m_capacity = 0;
+		m_shift = 64;
+	}
+
+	template<typename T_Key, typename T_Value, typename T_Hash, typename T_Equal>
+	inline void Swap(Hash_map<T_Key, T_Value, T_Hash, T_Equal>& left, Hash_map<T_Key, T_Value, T_Hash, T_Equal>& right)
+	{
+		left.Swap(right);
+	}
+}
+
+#endif // !DVTL_HASH_MAP_H
@@ -1,6 +1,8 @@
 #ifndef DVTL_INITIALIZER_LIST_H
 #define DVTL_INITIALIZER_LIST_H
 
+#include <cstddef>
+
 namespace DVTL
 {
 	template<typename T>
@@ -2,6 +2,7 @@
 #define DVTL_MAP_H
 
 #include "Algorithm.h"
+#include "Allocator.h"
 
 namespace DVTL {
 template<typename T_Key, typename T_Value>
@@ -20,6 +21,10 @@ public:
 	Map(Map&& right);
 	Map(Initializer_list<Pair<T_Key, T_Value>> init_list);
 
+	//builds a perfectly balanced tree in O(n) with the nodes in one block,
+	//unsorted input falls back to inserting the elements one by one
+	template<typename T_Iterator> static Map From_sorted(T_Iterator first, T_Iterator last);
+
 	Map& operator=(const Map& right);
 	Map& operator=(Map&& right);
 
@@ -35,6 +40,22 @@ public:
 	iterator Find(const T_Key& key);
 	const_iterator Find(const T_Key& key) const;
 
+	//order statistics from the subtree sizes, all O(log n):
+	//Select gives the element with index elements before it or End(), Rank the number of keys less than key,
+	//Count_range the number of keys in [low, high)
+	iterator Select(size_t index);
+	const_iterator Select(size_t index) const;
+	size_t Rank(const T_Key& key) const;
+	size_t Count_range(const T_Key& low, const T_Key& high) const;
+
+	//bounds in O(log n): the first key not less than key, the first key greater than key and the range between them
+	iterator Lower_bound(const T_Key& key);
+	const_iterator Lower_bound(const T_Key& key) const;
+	iterator Upper_bound(const T_Key& key);
+	const_iterator Upper_bound(const T_Key& key) const;
+	Pair<iterator, iterator> Equal_range(const T_Key& key);
+	Pair<const_iterator, const_iterator> Equal_range(const T_Key& key) const;
+
 	//working with data
 	void Clear();
 	bool Empty() const;
@@ -42,11 +63,22 @@ public:
 	size_t Size() const;
 	void Swap(Map<T_Key, T_Value>& right);
 
-	//adding and removing elements to a Map
+	//adding and removing elements to a Map,
+	//inserting functions leave an existing element untouched and return it with false;
+	//erasing functions return the element after the removed ones, Erase(first, last) splits the range off
+	//and joins what is left in O(log n) restructuring plus one step per removed element
 	iterator Erase(const T_Key& key);
-	iterator Insert(Pair<T_Key, T_Value>&& pair);
-	iterator Insert(const Pair<T_Key, T_Value>& pair); 
-	iterator Insert(const T_Key& key, const T_Value& val);
+	iterator Erase(const const_iterator& position);
+	iterator Erase(const const_iterator& first, const const_iterator& last);
+	Pair<iterator, bool> Insert(Pair<T_Key, T_Value>&& pair);
+	Pair<iterator, bool> Insert(const Pair<T_Key, T_Value>& pair);
+	Pair<iterator, bool> Insert(const T_Key& key, const T_Value& val);
+	template<typename T_Iterator> void Insert(T_Iterator first, T_Iterator last);
+	template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(const T_Key& key, T_Arg&& val);
+	template<typename T_Arg> Pair<iterator, bool> Insert_or_assign(T_Key&& key, T_Arg&& val);
+	template<class... Types> Pair<iterator, bool> Emplace(Types&&... args);
+	template<class... Types> Pair<iterator, bool> Try_emplace(const T_Key& key, Types&&... args);
+	template<class... Types> Pair<iterator, bool> Try_emplace(T_Key&& key, Types&&... args);
 
 	//getting iterators begin and end
 	iterator Begin()	{ return iterator(findMin(m_root)); }
@@ -65,20 +97,39 @@ public:
 
 private:
 	Node* m_root;
-
-	static void deleteNodeWithChild(Node* ptr);
+	Node_pool<Node> m_pool;
+
+	template<class... Types> Node* createNode(Types&&... args);
+	void destroyNode(Node* node);
+	void destroyAllNodes();
+	void destroySubtree(Node* node);
+	Node* copyTree(const Node* node, Node* parent);
+	template<typename T_Iterator> size_t createSortedNodes(T_Iterator first, T_Iterator last, size_t count, Node*& nodes);
+	void mergeSortedNodes(Node* nodes, size_t count);
+	static Node* nodeAt(Node* nodes, size_t index) { return nodes + index; }
+	static Node* nodeAt(Node* const* nodes, size_t index) { return nodes[index]; }
+	template<typename T_Nodes> static Node* buildBalanced(T_Nodes nodes, size_t count, Node* parent);
 	static void updateHeightAndSize(Node* node);
-	static Node* insertInTree(Node* node, Pair<T_Key, T_Value>&& pair);
+	Node* findInsertPosition(const T_Key& key, Node*& parent, bool& toLeft) const;
+	iterator linkNode(Node* node, Node* parent, bool toLeft);
 	static Node* balanceTree(Node* node);
 	static Node* rotateLeft(Node* node);
 	static Node* rotateRight(Node* node);
-	static Node* removeFromTree(Node* node, const T_Key& val);
+	void eraseNode(Node* node);
+	static Node* rebalanceToRoot(Node* node);
+	static void attachChildren(Node* node, Node* left, Node* right);
+	static Node* joinTrees(Node* left, Node* node, Node* right);
+	static Node* joinTrees(Node* left, Node* right);
+	static void splitTree(Node* node, const T_Key& key, Node*& less, Node*& notLess);
+	Node* lowerBound(const T_Key& key) const;
+	Node* upperBound(const T_Key& key) const;
 	static Node* findMin(Node* node);
 	static Node* findMax(Node* node);
-	static Node* removeMin(Node* node);
 	static int getHeight(Node* node);
 	static int getBalanceFactor(Node* node);
 	static size_t getSize(Node* node);
+	static Node* selectNode(Node* node, size_t index);
+	static Node* advanceNode(Node* node, ptrdiff_t count);
 
 	static Node* iteratorHelpIncrement(Node* node);
 	static Node* iteratorHelpDecrement(Node* node);
@@ -95,7 +146,8 @@ struct Map<T_Key, T_Value>::Node {
 
 	Node(const Pair<T_Key, T_Value>& value) : data(value), parent(nullptr), left(nullptr), right(nullptr), height(1), size(1) {}
 	Node(Pair<T_Key, T_Value>&& value) : data(Move(value)), parent(nullptr), left(nullptr), right(nullptr), height(1), size(1) {}
-	Node(const Node& right, Node* parentNode) : data(right.data), parent(parentNode), left(new Node(*right.left, this)), right(new Node(*right.right, this)), height(right.height), size(right.size) {}
+	template<class... Types>
+	Node(In_place_t, Types&&... args) : data(Forward<Types>(args)...), parent(nullptr), left(nullptr), right(nullptr), height(1), size(1) {}
 
 	~Node() {};
 };
@@ -132,7 +184,7 @@ public:
 	iterator& operator--()
 	{
 		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(ptr);
-		return this;
+		return *this;
 	}
 
 	const iterator operator++(int) 
@@ -149,6 +201,21 @@ public:
 		return it;
 	}
 
+	iterator& operator+=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(ptr, count);
+		return *this;
+	}
+
+	iterator& operator-=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(ptr, -count);
+		return *this;
+	}
+
+	iterator operator+(ptrdiff_t count) const { return iterator(Map<T_Key, T_Value>::advanceNode(ptr, count)); }
+	iterator operator-(ptrdiff_t count) const { return iterator(Map<T_Key, T_Value>::advanceNode(ptr, -count)); }
+
 	//transformation
 	typename Map<T_Key, T_Value>::const_iterator get_const() const { return  typename Map<T_Key, T_Value>::const_iterator(*this); }
 	typename Map<T_Key, T_Value>::reverse_iterator get_revers() const { return typename Map<T_Key, T_Value>::reverse_iterator(*this); }
@@ -184,30 +251,45 @@ public:
 	//mathematical operators
 	const_iterator& operator++()
 	{
-		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(get());
 		return *this;
 	}
 
 	const_iterator& operator--()
 	{
-		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(get());
 		return *this;
 	}
 
 	const const_iterator operator++(int)
 	{
 		const_iterator it(ptr);
-		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(get());
 		return it;
 	}
 
 	const const_iterator operator--(int)
 	{
 		const_iterator it(ptr);
-		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(get());
 		return it;
 	}
 
+	const_iterator& operator+=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(get(), count);
+		return *this;
+	}
+
+	const_iterator& operator-=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(get(), -count);
+		return *this;
+	}
+
+	const_iterator operator+(ptrdiff_t count) const { return const_iterator(Map<T_Key, T_Value>::advanceNode(get(), count)); }
+	const_iterator operator-(ptrdiff_t count) const { return const_iterator(Map<T_Key, T_Value>::advanceNode(get(), -count)); }
+
 	//transformation
 	typename Map<T_Key, T_Value>::const_reverse_iterator get_revers() const { return typename Map<T_Key, T_Value>::const_reverse_iterator(*this); }
 
@@ -249,7 +331,7 @@ public:
 	reverse_iterator& operator--()
 	{
 		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(ptr);
-		return this;
+		return *this;
 	}
 
 	const reverse_iterator operator++(int)
@@ -266,6 +348,21 @@ public:
 		return it;
 	}
 
+	reverse_iterator& operator+=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(ptr, -count);
+		return *this;
+	}
+
+	reverse_iterator& operator-=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(ptr, count);
+		return *this;
+	}
+
+	reverse_iterator operator+(ptrdiff_t count) const { return reverse_iterator(Map<T_Key, T_Value>::advanceNode(ptr, -count)); }
+	reverse_iterator operator-(ptrdiff_t count) const { return reverse_iterator(Map<T_Key, T_Value>::advanceNode(ptr, count)); }
+
 	//transformation
 	typename Map<T_Key, T_Value>::const_reverse_iterator get_const() const { return  typename Map<T_Key, T_Value>::const_reverse_iterator(*this); }
 	typename Map<T_Key, T_Value>::iterator get_revers() const { return typename Map<T_Key, T_Value>::iterator(*this); }
@@ -301,30 +398,45 @@ public:
 	//mathematical operators
 	const_reverse_iterator& operator++()
 	{
-		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(get());
 		return *this;
 	}
 
 	const_reverse_iterator& operator--()
 	{
-		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(get());
 		return *this;
 	}
 
 	const const_reverse_iterator operator++(int)
 	{
 		const_iterator it(ptr);
-		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpDecrement(get());
 		return it;
 	}
 
 	const const_reverse_iterator operator--(int)
 	{
 		const_iterator it(ptr);
-		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(ptr);
+		ptr = Map<T_Key, T_Value>::iteratorHelpIncrement(get());
 		return it;
 	}
 
+	const_reverse_iterator& operator+=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(get(), -count);
+		return *this;
+	}
+
+	const_reverse_iterator& operator-=(ptrdiff_t count)
+	{
+		ptr = Map<T_Key, T_Value>::advanceNode(get(), count);
+		return *this;
+	}
+
+	const_reverse_iterator operator+(ptrdiff_t count) const { return const_reverse_iterator(Map<T_Key, T_Value>::advanceNode(get(), -count)); }
+	const_reverse_iterator operator-(ptrdiff_t count) const { return const_reverse_iterator(Map<T_Key, T_Value>::advanceNode(get(), count)); }
+
 	//transformation
 	typename Map<T_Key, T_Value>::const_iterator get_revers() const { return typename Map<T_Key, T_Value>::const_iterator(*this); }
 
@@ -338,19 +450,30 @@ template<typename T_Key, typename T_Value>
 inline Map<T_Key, T_Value>::Map():m_root(nullptr){}
 
 template<typename T_Key, typename T_Value>
-inline Map<T_Key, T_Value>::Map(const Map& right):m_root(new Node(*right.m_root, nullptr)){}
+inline Map<T_Key, T_Value>::Map(const Map& right):m_root(nullptr)
+{
+	m_root = copyTree(right.m_root, nullptr);
+}
 
 template<typename T_Key, typename T_Value>
-inline Map<T_Key, T_Value>::Map(Map&& right):m_root(right.m_root)
+inline Map<T_Key, T_Value>::Map(Map&& right):m_root(right.m_root), m_pool(Move(right.m_pool))
 {
 	right.m_root = nullptr;
 }
 
 template<typename T_Key, typename T_Value>
-inline Map<T_Key, T_Value>::Map(Initializer_list<Pair<T_Key, T_Value>> init_list)
+inline Map<T_Key, T_Value>::Map(Initializer_list<Pair<T_Key, T_Value>> init_list):m_root(nullptr)
 {
-	for (int i = 0; i < init_list.Size(); i++)
-		this->Insert(*(init_list.Begin() + i));
+	Insert(init_list.Begin(), init_list.End());
+}
+
+template<typename T_Key, typename T_Value>
+template<typename T_Iterator>
+inline Map<T_Key, T_Value> Map<T_Key, T_Value>::From_sorted(T_Iterator first, T_Iterator last)
+{
+	Map map;
+	map.Insert(first, last);
+	return map;
 }
 
 template<typename T_Key, typename T_Value>
@@ -358,8 +481,8 @@ inline Map<T_Key, T_Value>& Map<T_Key, T_Value>::operator=(const Map& right)
 {
 	if (m_root == right.m_root)return *this;
 
-	deleteNodeWithChild(m_root);
-	m_root = new Node(*right.m_root, nullptr);
+	destroyAllNodes();
+	m_root = copyTree(right.m_root, nullptr);
 
 	return *this;
 }
@@ -369,8 +492,9 @@ inline Map<T_Key, T_Value>& Map<T_Key, T_Value>::operator=(Map&& right)
 {
 	if (m_root == right.m_root)return *this;
 
-	deleteNodeWithChild(m_root);
+	destroyAllNodes();
 	m_root = right.m_root;
+	m_pool = Move(right.m_pool);
 	right.m_root = nullptr;
 
 	return *this;
@@ -379,7 +503,7 @@ inline Map<T_Key, T_Value>& Map<T_Key, T_Value>::operator=(Map&& right)
 template<typename T_Key, typename T_Value>
 inline Map<T_Key, T_Value>::~Map()
 {
-	deleteNodeWithChild(m_root);
+	destroyAllNodes();
 }
 
 template<typename T_Key, typename T_Value>
@@ -397,7 +521,6 @@ inline T_Value& Map<T_Key, T_Value>::At(const T_Key& key)
 	}
 	
 	throw "out of range map";
-	return T_Value();
 }
 
 template<typename T_Key, typename T_Value>
@@ -421,7 +544,6 @@ inline const T_Value& Map<T_Key, T_Value>::At(const T_Key& key) const
 	}
 
 	throw "out of range map";
-	return T_Value();
 }
 
 template<typename T_Key, typename T_Value>
@@ -460,11 +582,89 @@ inline typename Map<T_Key, T_Value>::const_iterator Map<T_Key, T_Value>::Find(co
 	return const_iterator(node);
 }
 
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Select(size_t index)
+{
+	return iterator(selectNode(m_root, index));
+}
+
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::const_iterator Map<T_Key, T_Value>::Select(size_t index) const
+{
+	return const_iterator(selectNode(m_root, index));
+}
+
+//every step to the right passes the left subtree and the node itself
+template<typename T_Key, typename T_Value>
+inline size_t Map<T_Key, T_Value>::Rank(const T_Key& key) const
+{
+	size_t rank = 0;
+	Node* node = m_root;
+
+	while (node != nullptr) {
+		if (Less(node->data.First, key)) {
+			rank += 1 + getSize(node->left);
+			node = node->right;
+		}
+		else
+			node = node->left;
+	}
+
+	return rank;
+}
+
+template<typename T_Key, typename T_Value>
+inline size_t Map<T_Key, T_Value>::Count_range(const T_Key& low, const T_Key& high) const
+{
+	if (!Less(low, high)) return 0;
+	return Rank(high) - Rank(low);
+}
+
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Lower_bound(const T_Key& key)
+{
+	return iterator(lowerBound(key));
+}
+
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::const_iterator Map<T_Key, T_Value>::Lower_bound(const T_Key& key) const
+{
+	return const_iterator(lowerBound(key));
+}
+
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Upper_bound(const T_Key& key)
+{
+	return iterator(upperBound(key));
+}
+
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::const_iterator Map<T_Key, T_Value>::Upper_bound(const T_Key& key) const
+{
+	return const_iterator(upperBound(key));
+}
+
+//keys are unique, so the range holds the key's node or nothing
+template<typename T_Key, typename T_Value>
+inline Pair<typename Map<T_Key, T_Value>::iterator, typename Map<T_Key, T_Value>::iterator> Map<T_Key, T_Value>::Equal_range(const T_Key& key)
+{
+	Node* first = lowerBound(key);
+	Node* last = first != nullptr && !Less(key, first->data.First) ? iteratorHelpIncrement(first) : first;
+	return Pair<iterator, iterator>(iterator(first), iterator(last));
+}
+
+template<typename T_Key, typename T_Value>
+inline Pair<typename Map<T_Key, T_Value>::const_iterator, typename Map<T_Key, T_Value>::const_iterator> Map<T_Key, T_Value>::Equal_range(const T_Key& key) const
+{
+	Node* first = lowerBound(key);
+	Node* last = first != nullptr && !Less(key, first->data.First) ? iteratorHelpIncrement(first) : first;
+	return Pair<const_iterator, const_iterator>(const_iterator(first), const_iterator(last));
+}
+
 template<typename T_Key, typename T_Value>
 inline void Map<T_Key, T_Value>::Clear()
 {
-	deleteNodeWithChild(m_root);
-	m_root = nullptr;
+	destroyAllNodes();
 }
 
 template<typename T_Key, typename T_Value>
@@ -502,67 +702,376 @@ inline void Map<T_Key, T_Value>::Swap(Map<T_Key, T_Value>& right)
 	Node* tempNode = right.m_root;
 	right.m_root = m_root;
 	m_root = tempNode;
+	m_pool.Swap(right.m_pool);
 }
 
 template<typename T_Key, typename T_Value>
 inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Erase(const T_Key& key)
 {
-	iterator retIt = Find(key);
-	retIt++;
-	m_root = removeFromTree(m_root, key);
-	return retIt;
+	iterator position = Find(key);
+	if (position == End()) return End();
+
+	return Erase(position);
 }
 
+//nodes do not move, so the successor found before unlinking stays valid
 template<typename T_Key, typename T_Value>
-inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Insert(Pair<T_Key, T_Value>&& pair)
+inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Erase(const const_iterator& position)
 {
-	T_Key copyForFind = pair.First;
-	m_root = insertInTree(m_root, Move(pair));
-	return Find(copyForFind);
+	Node* node = position.get();
+	Node* next = iteratorHelpIncrement(node);
+	eraseNode(node);
+	return iterator(next);
 }
 
+//the tree is split at both ends of the range, the middle part is destroyed and the outer parts are joined
 template<typename T_Key, typename T_Value>
-inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Insert(const Pair<T_Key, T_Value>& pair)
+inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Erase(const const_iterator& first, const const_iterator& last)
 {
-	return Insert(Pair<T_Key, T_Value>(pair));
+	Node* begin = first.get();
+	Node* end = last.get();
+	if (begin == end) return iterator(end);
+
+	if (end != nullptr && iteratorHelpIncrement(begin) == end) {
+		eraseNode(begin);
+		return iterator(end);
+	}
+
+	Node* less;
+	Node* rest;
+	splitTree(m_root, begin->data.First, less, rest);
+
+	Node* middle = rest;
+	Node* greater = nullptr;
+	if (end != nullptr) splitTree(rest, end->data.First, middle, greater);
+
+	destroySubtree(middle);
+	m_root = joinTrees(less, greater);
+	return iterator(end);
 }
 
 template<typename T_Key, typename T_Value>
-inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::Insert(const T_Key& key, const T_Value& val)
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Insert(Pair<T_Key, T_Value>&& pair)
 {
-	return Insert(Pair<T_Key, T_Value>(key, val));
+	Node* parent;
+	bool toLeft;
+	Node* node = findInsertPosition(pair.First, parent, toLeft);
+	if (node != nullptr) return Pair<iterator, bool>(iterator(node), false);
+
+	return Pair<iterator, bool>(linkNode(createNode(Move(pair)), parent, toLeft), true);
 }
 
 template<typename T_Key, typename T_Value>
-inline void Map<T_Key, T_Value>::deleteNodeWithChild(Node* ptr)
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Insert(const Pair<T_Key, T_Value>& pair)
 {
-	if (ptr == nullptr) return;
+	Node* parent;
+	bool toLeft;
+	Node* node = findInsertPosition(pair.First, parent, toLeft);
+	if (node != nullptr) return Pair<iterator, bool>(iterator(node), false);
 
-	deleteNodeWithChild(ptr->left);
-	deleteNodeWithChild(ptr->right);
-	delete ptr;
+	return Pair<iterator, bool>(linkNode(createNode(pair), parent, toLeft), true);
 }
 
 template<typename T_Key, typename T_Value>
-inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::insertInTree(Node* node, Pair<T_Key, T_Value>&& pair)
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Insert(const T_Key& key, const T_Value& val)
 {
-	if (node == nullptr)
-		return new Node(Move(pair));
+	return Try_emplace(key, val);
+}
 
-	if (pair.First < node->data.First) {
-		node->left = insertInTree(node->left, Move(pair));
-		node->left->parent = node;
+//a sorted range is built into one block of nodes and merged with the tree in O(n + count),
+//unless it is small enough that inserting one by one is cheaper; an unsorted range is inserted one by one
+template<typename T_Key, typename T_Value>
+template<typename T_Iterator>
+inline void Map<T_Key, T_Value>::Insert(T_Iterator first, T_Iterator last)
+{
+	size_t count = 0;
+	bool sorted = true;
+	for (T_Iterator previous = first, current = first; current != last; previous = current, ++current, ++count)
+		if (sorted && count != 0 && Less((*current).First, (*previous).First)) sorted = false;
+
+	if (count == 0) return;
+
+	//merging visits every node, inserting costs about a descent per element
+	size_t size = Size();
+	if (!sorted || count * static_cast<size_t>(getHeight(m_root)) < size) {
+		for (; first != last; ++first)
+			Insert(*first);
+		return;
 	}
-	else if (pair.First > node->data.First) {
-		node->right = insertInTree(node->right, Move(pair));
-		node->right->parent = node;
+
+	Node* nodes;
+	count = createSortedNodes(first, last, count, nodes);
+
+	if (m_root == nullptr)
+		m_root = buildBalanced(nodes, count, nullptr);
+	else
+		mergeSortedNodes(nodes, count);
+}
+
+template<typename T_Key, typename T_Value>
+template<typename T_Arg>
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Insert_or_assign(const T_Key& key, T_Arg&& val)
+{
+	Pair<iterator, bool> result = Try_emplace(key, Forward<T_Arg>(val));
+	if (!result.Second) result.First->Second = Forward<T_Arg>(val);
+	return result;
+}
+
+template<typename T_Key, typename T_Value>
+template<typename T_Arg>
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Insert_or_assign(T_Key&& key, T_Arg&& val)
+{
+	Pair<iterator, bool> result = Try_emplace(Move(key), Forward<T_Arg>(val));
+	if (!result.Second) result.First->Second = Forward<T_Arg>(val);
+	return result;
+}
+
+template<typename T_Key, typename T_Value>
+template<class... Types>
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Emplace(Types&&... args)
+{
+	//the key is only known once the element is built
+	Node* newNode = createNode(In_place, Forward<Types>(args)...);
+	Node* parent;
+	bool toLeft;
+	Node* node = findInsertPosition(newNode->data.First, parent, toLeft);
+
+	if (node != nullptr) {
+		destroyNode(newNode);
+		return Pair<iterator, bool>(iterator(node), false);
 	}
-	else {
-		node->data.Second = pair.Second;
-		return node;
+
+	return Pair<iterator, bool>(linkNode(newNode, parent, toLeft), true);
+}
+
+template<typename T_Key, typename T_Value>
+template<class... Types>
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Try_emplace(const T_Key& key, Types&&... args)
+{
+	Node* parent;
+	bool toLeft;
+	Node* node = findInsertPosition(key, parent, toLeft);
+	if (node != nullptr) return Pair<iterator, bool>(iterator(node), false);
+
+	return Pair<iterator, bool>(linkNode(createNode(In_place, In_place, key, Forward<Types>(args)...), parent, toLeft), true);
+}
+
+template<typename T_Key, typename T_Value>
+template<class... Types>
+inline Pair<typename Map<T_Key, T_Value>::iterator, bool> Map<T_Key, T_Value>::Try_emplace(T_Key&& key, Types&&... args)
+{
+	Node* parent;
+	bool toLeft;
+	Node* node = findInsertPosition(key, parent, toLeft);
+	if (node != nullptr) return Pair<iterator, bool>(iterator(node), false);
+
+	return Pair<iterator, bool>(linkNode(createNode(In_place, In_place, Move(key), Forward<Types>(args)...), parent, toLeft), true);
+}
+
+template<typename T_Key, typename T_Value>
+template<class... Types>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::createNode(Types&&... args)
+{
+	Node* node = m_pool.Allocate();
+	Allocator::ConstructForward(node, Forward<Types>(args)...);
+	return node;
+}
+
+template<typename T_Key, typename T_Value>
+inline void Map<T_Key, T_Value>::destroyNode(Node* node)
+{
+	Allocator::Destroy(node);
+	m_pool.Deallocate(node);
+}
+
+//elements are destroyed without recursion, then the pool frees its chunks at once
+template<typename T_Key, typename T_Value>
+inline void Map<T_Key, T_Value>::destroyAllNodes()
+{
+	if (!Is_trivially_destructible_v<Pair<T_Key, T_Value>>) {
+		Node* node = m_root;
+		while (node != nullptr) {
+			if (node->left != nullptr)
+				node = node->left;
+			else if (node->right != nullptr)
+				node = node->right;
+			else {
+				Node* parent = node->parent;
+				if (parent != nullptr) {
+					if (parent->left == node)
+						parent->left = nullptr;
+					else
+						parent->right = nullptr;
+				}
+				Allocator::Destroy(node);
+				node = parent;
+			}
+		}
+	}
+
+	m_root = nullptr;
+	m_pool.Release();
+}
+
+//returns the nodes of a detached subtree to the pool one by one, without recursion
+template<typename T_Key, typename T_Value>
+inline void Map<T_Key, T_Value>::destroySubtree(Node* node)
+{
+	while (node != nullptr) {
+		if (node->left != nullptr)
+			node = node->left;
+		else if (node->right != nullptr)
+			node = node->right;
+		else {
+			Node* parent = node->parent;
+			if (parent != nullptr) {
+				if (parent->left == node)
+					parent->left = nullptr;
+				else
+					parent->right = nullptr;
+			}
+			destroyNode(node);
+			node = parent;
+		}
 	}
+}
+
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::copyTree(const Node* node, Node* parent)
+{
+	if (node == nullptr) return nullptr;
 
-	return balanceTree(node);
+	Node* copy = createNode(node->data);
+	copy->parent = parent;
+	copy->height = node->height;
+	copy->size = node->size;
+	copy->left = copyTree(node->left, copy);
+	copy->right = copyTree(node->right, copy);
+	return copy;
+}
+
+//constructs the nodes of a sorted range side by side, for repeated keys only the first is kept;
+//returns the number of nodes built
+template<typename T_Key, typename T_Value>
+template<typename T_Iterator>
+inline size_t Map<T_Key, T_Value>::createSortedNodes(T_Iterator first, T_Iterator last, size_t count, Node*& nodes)
+{
+	nodes = m_pool.Allocate(count);
+
+	size_t built = 0;
+	for (; first != last; ++first) {
+		if (built != 0 && !Less(nodes[built - 1].data.First, (*first).First)) continue;
+		new (nodes + built) Node(*first);
+		++built;
+	}
+
+	for (size_t i = built; i < count; ++i)
+		m_pool.Deallocate(nodes + i);
+
+	return built;
+}
+
+//merges the tree with sorted detached nodes and rebuilds it balanced,
+//an existing key keeps its element and the new node goes back to the pool
+template<typename T_Key, typename T_Value>
+inline void Map<T_Key, T_Value>::mergeSortedNodes(Node* nodes, size_t count)
+{
+	Vector<Node*> merged;
+	merged.Reserve(Size() + count);
+
+	Node* node = findMin(m_root);
+	size_t index = 0;
+	while (node != nullptr || index < count) {
+		if (index == count || (node != nullptr && Less(node->data.First, nodes[index].data.First))) {
+			merged.Push_back(node);
+			node = iteratorHelpIncrement(node);
+		}
+		else if (node == nullptr || Less(nodes[index].data.First, node->data.First))
+			merged.Push_back(nodes + index++);
+		else
+			destroyNode(nodes + index++);
+	}
+
+	m_root = buildBalanced(merged.Data(), merged.Size(), nullptr);
+}
+
+//the middle node becomes the root and both halves are built the same way,
+//subtree sizes differ by at most one so the heights do too
+template<typename T_Key, typename T_Value>
+template<typename T_Nodes>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::buildBalanced(T_Nodes nodes, size_t count, Node* parent)
+{
+	if (count == 0) return nullptr;
+
+	size_t middle = count / 2;
+	Node* node = nodeAt(nodes, middle);
+	node->parent = parent;
+	node->left = buildBalanced(nodes, middle, node);
+	node->right = buildBalanced(nodes + middle + 1, count - middle - 1, node);
+	updateHeightAndSize(node);
+	return node;
+}
+
+//one descent from the root, returns the node holding the key
+//or nullptr and the parent and side where a node with the key belongs
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::findInsertPosition(const T_Key& key, Node*& parent, bool& toLeft) const
+{
+	Node* node = m_root;
+	parent = nullptr;
+	toLeft = false;
+
+	while (node != nullptr) {
+		parent = node;
+		if (Less(key, node->data.First)) {
+			toLeft = true;
+			node = node->left;
+		}
+		else if (Less(node->data.First, key)) {
+			toLeft = false;
+			node = node->right;
+		}
+		else
+			return node;
+	}
+
+	return nullptr;
+}
+
+//attaches a new leaf and restores sizes and balance on the way back to the root,
+//rotations move links and not nodes so the returned iterator stays valid
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::iterator Map<T_Key, T_Value>::linkNode(Node* node, Node* parent, bool toLeft)
+{
+	node->parent = parent;
+
+	if (parent == nullptr) {
+		m_root = node;
+		return iterator(node);
+	}
+
+	if (toLeft)
+		parent->left = node;
+	else
+		parent->right = node;
+
+	//above the first subtree that keeps its height only the sizes change
+	bool heightChanged = true;
+	for (Node* current = parent; current != nullptr;) {
+		if (!heightChanged) {
+			++current->size;
+			current = current->parent;
+			continue;
+		}
+
+		int oldHeight = current->height;
+		Node* subtreeRoot = balanceTree(current);
+		heightChanged = subtreeRoot->height != oldHeight;
+		if (subtreeRoot->parent == nullptr) m_root = subtreeRoot;
+		current = subtreeRoot->parent;
+	}
+
+	return iterator(node);
 }
 
 template<typename T_Key, typename T_Value>
@@ -633,44 +1142,192 @@ inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::rotateRight(Node
 	return newRoot;
 }
 
+//unlinks the node, a node with two children is replaced by its successor,
+//then sizes and balance are restored from the lowest changed node up to the root
 template<typename T_Key, typename T_Value>
-inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::removeFromTree(Node* node, const T_Key& value)
+inline void Map<T_Key, T_Value>::eraseNode(Node* node)
 {
-	if (node == nullptr)
-		return nullptr;
+	Node* replacement;
+	Node* start;
+
+	if (node->left != nullptr && node->right != nullptr) {
+		replacement = findMin(node->right);
+		if (replacement->parent == node)
+			start = replacement;
+		else {
+			start = replacement->parent;
+			start->left = replacement->right;
+			if (replacement->right != nullptr) replacement->right->parent = start;
+			replacement->right = node->right;
+			node->right->parent = replacement;
+		}
+		replacement->left = node->left;
+		node->left->parent = replacement;
+	}
+	else {
+		replacement = node->left != nullptr ? node->left : node->right;
+		start = node->parent;
+	}
+
+	Node* parent = node->parent;
+	if (replacement != nullptr) replacement->parent = parent;
+	if (parent == nullptr)
+		m_root = replacement;
+	else if (parent->left == node)
+		parent->left = replacement;
+	else
+		parent->right = replacement;
+
+	destroyNode(node);
+	if (start != nullptr) m_root = rebalanceToRoot(start);
+}
 
-	if (value < node->data.First) {
-		node->left = removeFromTree(node->left, value);
-		if (node->left != nullptr) node->left->parent = node;
+//balances every node from node up and returns the root of the whole tree
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::rebalanceToRoot(Node* node)
+{
+	while (true) {
+		node = balanceTree(node);
+		if (node->parent == nullptr) return node;
+		node = node->parent;
 	}
-	else if (value > node->data.First) {
-		node->right = removeFromTree(node->right, value);
-		if (node->right != nullptr) node->right->parent = node;
+}
+
+template<typename T_Key, typename T_Value>
+inline void Map<T_Key, T_Value>::attachChildren(Node* node, Node* left, Node* right)
+{
+	node->left = left;
+	node->right = right;
+	if (left != nullptr) left->parent = node;
+	if (right != nullptr) right->parent = node;
+	updateHeightAndSize(node);
+}
+
+//joins the detached trees left < node < right: node goes down the spine of the taller tree
+//to a subtree of about the other tree's height, the rotations back up cost O(height difference)
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::joinTrees(Node* left, Node* node, Node* right)
+{
+	int leftHeight = getHeight(left);
+	int rightHeight = getHeight(right);
+
+	if (leftHeight > rightHeight + 1) {
+		Node* parent = left;
+		while (getHeight(parent->right) > rightHeight + 1)
+			parent = parent->right;
+
+		attachChildren(node, parent->right, right);
+		parent->right = node;
+		node->parent = parent;
+		return rebalanceToRoot(parent);
+	}
+
+	if (rightHeight > leftHeight + 1) {
+		Node* parent = right;
+		while (getHeight(parent->left) > leftHeight + 1)
+			parent = parent->left;
+
+		attachChildren(node, left, parent->left);
+		parent->left = node;
+		node->parent = parent;
+		return rebalanceToRoot(parent);
+	}
+
+	attachChildren(node, left, right);
+	node->parent = nullptr;
+	return node;
+}
+
+//joins the detached trees left < right, the minimum of right becomes the joining node
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::joinTrees(Node* left, Node* right)
+{
+	if (right == nullptr) return left;
+	if (left == nullptr) return right;
+
+	Node* node = findMin(right);
+	Node* parent = node->parent;
+	if (node->right != nullptr) node->right->parent = parent;
+
+	if (parent == nullptr)
+		right = node->right;
+	else {
+		parent->left = node->right;
+		right = rebalanceToRoot(parent);
+	}
+
+	return joinTrees(left, node, right);
+}
+
+//splits the detached tree into the keys less than key and the rest,
+//the joins along the search path add up to O(log n)
+template<typename T_Key, typename T_Value>
+inline void Map<T_Key, T_Value>::splitTree(Node* node, const T_Key& key, Node*& less, Node*& notLess)
+{
+	if (node == nullptr) {
+		less = nullptr;
+		notLess = nullptr;
+		return;
+	}
+
+	Node* left = node->left;
+	Node* right = node->right;
+	if (left != nullptr) left->parent = nullptr;
+	if (right != nullptr) right->parent = nullptr;
+
+	if (Less(node->data.First, key)) {
+		Node* lower;
+		splitTree(right, key, lower, notLess);
+		less = joinTrees(left, node, lower);
 	}
 	else {
-		Node* left = node->left;
-		Node* right = node->right;
-		delete node;
+		Node* upper;
+		splitTree(left, key, less, upper);
+		notLess = joinTrees(upper, node, right);
+	}
+}
+
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::lowerBound(const T_Key& key) const
+{
+	Node* node = m_root;
+	Node* bound = nullptr;
+
+	while (node != nullptr) {
+		if (Less(node->data.First, key))
+			node = node->right;
+		else {
+			bound = node;
+			node = node->left;
+		}
+	}
 
-		if (right == nullptr)
-			return left;
-		if (left == nullptr)
-			return right;
+	return bound;
+}
 
-		Node* minNode = findMin(right);
-		minNode->right = removeMin(right);
-		if (minNode->right != nullptr) minNode->right->parent = minNode;
-		minNode->left = left;
-		left->parent = minNode;
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::upperBound(const T_Key& key) const
+{
+	Node* node = m_root;
+	Node* bound = nullptr;
 
-		return balanceTree(minNode);
+	while (node != nullptr) {
+		if (Less(key, node->data.First)) {
+			bound = node;
+			node = node->left;
+		}
+		else
+			node = node->right;
 	}
 
-	return balanceTree(node);
+	return bound;
 }
+
 template<typename T_Key, typename T_Value>
 inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::findMin(Node* node) 
 {
+	if (node == nullptr) return nullptr; //empty map, begin is end
+
 	while (node->left != nullptr)
 		node = node->left;
 	return node;
@@ -679,21 +1336,13 @@ inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::findMin(Node* no
 template<typename T_Key, typename T_Value>
 inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::findMax(Node* node)
 {
+	if (node == nullptr) return nullptr; //empty map, begin is end
+
 	while (node->right != nullptr)
 		node = node->right;
 	return node;
 }
 
-template<typename T_Key, typename T_Value>
-inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::removeMin(Node* node) 
-{
-	if (node->left == nullptr)
-		return node->right;
-	node->left = removeMin(node->left);
-	if (node->left != nullptr) node->left->parent = node;
-	return balanceTree(node);
-}
-
 template<typename T_Key, typename T_Value>
 inline void Map<T_Key, T_Value>::updateHeightAndSize(Node* node)
 {
@@ -719,6 +1368,45 @@ inline size_t Map<T_Key, T_Value>::getSize(Node* node)
 	return node->size;
 }
 
+//element with index elements before it in the subtree of node, nullptr when there is none
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::selectNode(Node* node, size_t index)
+{
+	if (index >= getSize(node)) return nullptr;
+
+	while (true) {
+		size_t leftSize = getSize(node->left);
+		if (index < leftSize)
+			node = node->left;
+		else if (index == leftSize)
+			return node;
+		else {
+			index -= leftSize + 1;
+			node = node->right;
+		}
+	}
+}
+
+//climbs until the target lies in the current subtree and selects it there,
+//so the cost grows with the logarithm of the distance; leaving the tree gives nullptr
+template<typename T_Key, typename T_Value>
+inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::advanceNode(Node* node, ptrdiff_t count)
+{
+	if (node == nullptr || count == 0) return node;
+
+	//target index relative to the subtree of node
+	ptrdiff_t target = static_cast<ptrdiff_t>(getSize(node->left)) + count;
+
+	while (target < 0 || target >= static_cast<ptrdiff_t>(node->size)) {
+		Node* parent = node->parent;
+		if (parent == nullptr) return nullptr;
+		if (parent->right == node) target += static_cast<ptrdiff_t>(getSize(parent->left)) + 1;
+		node = parent;
+	}
+
+	return selectNode(node, static_cast<size_t>(target));
+}
+
 template<typename T_Key, typename T_Value>
 inline typename Map<T_Key, T_Value>::Node* Map<T_Key, T_Value>::iteratorHelpIncrement(Node* node)
 {
@@ -764,7 +1452,7 @@ inline int Map<T_Key, T_Value>::getBalanceFactor(Node* node)
 {
 	if (node == nullptr)
 		return 0;
-	return (getHeight(node->left) / (getHeight(node->right)+1)) - (getHeight(node->right) / (getHeight(node->left)+1));
+	return getHeight(node->left) - getHeight(node->right);
 }
 
 template<typename T_Key, typename T_Value>
@@ -0,0 +1,91 @@
+#ifndef DVTL_PARALLEL_H
+#define DVTL_PARALLEL_H
+
+#include <exception>
+#include <thread>
+
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace DVTL
+{
+	//splits the output into parts of equal size by co-ranking and merges every part on its own thread
+	template<typename T_RangeIterator, typename T_IteratorOutput, typename T_Predicate>
+	inline T_IteratorOutput Merge_k_parallel(T_RangeIterator firstRange, T_RangeIterator lastRange, T_IteratorOutput result, size_t parts, T_Predicate predicate)
+	{
+		typedef Remove_cvref_t<decltype((*firstRange).First)> T_Iterator;
+
+		size_t count = static_cast<size_t>(lastRange - firstRange);
+		size_t total = 0;
+
+		for (T_RangeIterator it = firstRange; it != lastRange; ++it)
+			total += static_cast<size_t>((*it).Second - (*it).First);
+
+		if (parts < 2 || total < parts)
+			return Merge_k(firstRange, lastRange, result, predicate);
+
+		Vector<T_Iterator> bounds((parts + 1) * count, (*firstRange).First);
+
+		for (size_t part = 0; part <= parts; ++part)
+			Merge_k_split(firstRange, lastRange, total / parts * part + Min(part, total % parts), bounds.Begin() + part * count, predicate);
+
+		auto mergePart = [&](size_t part)
+		{
+			Vector<Pair<T_Iterator, T_Iterator>> runs;
+			runs.Reserve(count);
+
+			for (size_t i = 0; i < count; ++i)
+				runs.Emplace_back(bounds[part * count + i], bounds[(part + 1) * count + i]);
+
+			Merge_k(runs.Begin(), runs.End(), result + (total / parts * part + Min(part, total % parts)), predicate);
+		};
+
+		//an exception must not leave a thread body, so every part stores its own and the first is rethrown once all are joined
+		Vector<std::exception_ptr> errors(parts, std::exception_ptr());
+		auto runPart = [&](size_t part)
+		{
+			try
+			{
+				mergePart(part);
+			}
+			catch (...)
+			{
+				errors[part] = std::current_exception();
+			}
+		};
+
+		Vector<std::thread> threads;
+		threads.Reserve(parts - 1);
+
+		//started threads are joined before a failed start leaves, a joinable thread terminates on destruction
+		try
+		{
+			for (size_t part = 1; part < parts; ++part)
+				threads.Emplace_back(runPart, part);
+		}
+		catch (...)
+		{
+			for (size_t i = 0; i < threads.Size(); ++i)
+				threads[i].join();
+			throw;
+		}
+
+		runPart(0);
+
+		for (size_t i = 0; i < threads.Size(); ++i)
+			threads[i].join();
+
+		for (size_t part = 0; part < parts; ++part)
+			if (errors[part]) std::rethrow_exception(errors[part]);
+
+		return result + total;
+	}
+
+	template<typename T_RangeIterator, typename T_IteratorOutput>
+	inline T_IteratorOutput Merge_k_parallel(T_RangeIterator firstRange, T_RangeIterator lastRange, T_IteratorOutput result, size_t parts)
+	{
+		return Merge_k_parallel(firstRange, lastRange, result, parts, [](const auto& left, const auto& right) { return left < right; });
+	}
+}
+
+#endif // !DVTL_PARALLEL_H
@@ -0,0 +1,325 @@
+#ifndef DVTL_PRIORITY_QUEUE_H
+#define DVTL_PRIORITY_QUEUE_H
+
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace DVTL
+{
+	//heap adapter over a random access container, T_Compare(a, b) means a is served before b;
+	//the default keeps the greatest element on top of a 4-ary heap
+	template<typename T, typename T_Container = Vector<T>, typename T_Compare = Greater_than<T>, size_t D = 4>
+	class Priority_queue
+	{
+	public:
+		//constructors
+					Priority_queue();
+		explicit	Priority_queue(const T_Compare& compare);
+		template<typename T_Iterator>
+		Priority_queue(T_Iterator first, T_Iterator last, const T_Compare& compare = T_Compare());
+
+		//getting queue data
+		inline size_t	Size()	const noexcept { return m_container.Size(); }
+		inline bool		Empty()	const noexcept { return m_container.Empty(); }
+		const T& Top() const;
+
+		//adding and removing elements
+		void Push(const T& value);
+		void Push(T&& value);
+		template<class... Types> void Emplace(Types&&... args);
+		void Pop();
+		void Clear();
+		void Swap(Priority_queue& right);
+	private:
+		T_Container m_container;
+		T_Compare m_compare;
+	};
+
+	//priority queue over integer ids in [0, capacity) that can change the priority of a queued id;
+	//the default serves the smallest priority first as shortest path searches expect,
+	//heap entries keep the priority next to the id so sifting never leaves the heap array
+	template<typename T_Priority, typename T_Compare = Less_than<T_Priority>, size_t D = 4>
+	class Indexed_priority_queue
+	{
+	public:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		//constructors
+		explicit Indexed_priority_queue(size_t capacity = 0, const T_Compare& compare = T_Compare());
+
+		//getting queue data
+		inline size_t	Size()		const noexcept { return m_heap.Size(); }
+		inline bool		Empty()		const noexcept { return m_heap.Empty(); }
+		inline size_t	Capacity()	const noexcept { return m_position.Size(); }
+		inline bool		Contains(size_t id) const noexcept { return id < m_position.Size() && m_position[id] != npos; }
+		size_t Top() const;
+		const T_Priority& Top_priority() const;
+		const T_Priority& Priority(size_t id) const;
+
+		//adding, updating and removing ids
+		void Reserve_ids(size_t capacity);
+		void Push(size_t id, const T_Priority& priority);
+		void Decrease_key(size_t id, const T_Priority& priority);
+		void Update(size_t id, const T_Priority& priority);
+		bool Push_or_decrease(size_t id, const T_Priority& priority);
+		void Pop();
+		void Erase(size_t id);
+		void Clear();
+	private:
+		struct Entry
+		{
+			T_Priority priority;
+			size_t id;
+		};
+
+		Vector<Entry> m_heap;
+		Vector<size_t> m_position;
+		T_Compare m_compare;
+
+		void siftUp(size_t hole, Entry& entry);
+		void siftDown(size_t hole, Entry& entry);
+		void place(size_t hole, Entry& entry);
+	};
+
+	//Priority_queue
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline Priority_queue<T, T_Container, T_Compare, D>::Priority_queue() :m_container(), m_compare() {}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline Priority_queue<T, T_Container, T_Compare, D>::Priority_queue(const T_Compare& compare) : m_container(), m_compare(compare) {}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	template<typename T_Iterator>
+	inline Priority_queue<T, T_Container, T_Compare, D>::Priority_queue(T_Iterator first, T_Iterator last, const T_Compare& compare) : m_container(), m_compare(compare)
+	{
+		for (; first != last; ++first)
+			m_container.Push_back(*first);
+
+		Make_heap_d<D>(m_container.Begin(), m_container.End(), m_compare);
+	}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline const T& Priority_queue<T, T_Container, T_Compare, D>::Top() const
+	{
+		if (m_container.Empty()) throw "top of empty priority queue";
+		return m_container.Front();
+	}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline void Priority_queue<T, T_Container, T_Compare, D>::Push(const T& value)
+	{
+		m_container.Push_back(value);
+		Push_heap_d<D>(m_container.Begin(), m_container.End(), m_compare);
+	}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline void Priority_queue<T, T_Container, T_Compare, D>::Push(T&& value)
+	{
+		m_container.Push_back(Move(value));
+		Push_heap_d<D>(m_container.Begin(), m_container.End(), m_compare);
+	}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	template<class... Types>
+	inline void Priority_queue<T, T_Container, T_Compare, D>::Emplace(Types&&... args)
+	{
+		m_container.Emplace_back(Forward<Types>(args)...);
+		Push_heap_d<D>(m_container.Begin(), m_container.End(), m_compare);
+	}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline void Priority_queue<T, T_Container, T_Compare, D>::Pop()
+	{
+		if (m_container.Empty()) throw "pop empty priority queue";
+
+		Pop_heap_d<D>(m_container.Begin(), m_container.End(), m_compare);
+		m_container.Pop_back();
+	}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline void Priority_queue<T, T_Container, T_Compare, D>::Clear()
+	{
+		m_container.Clear();
+	}
+
+	template<typename T, typename T_Container, typename T_Compare, size_t D>
+	inline void Priority_queue<T, T_Container, T_Compare, D>::Swap(Priority_queue& right)
+	{
+		m_container.Swap(right.m_container);
+		DVTL::Swap(m_compare, right.m_compare);
+	}
+
+	//Indexed_priority_queue
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline Indexed_priority_queue<T_Priority, T_Compare, D>::Indexed_priority_queue(size_t capacity, const T_Compare& compare) :m_heap(), m_position(capacity, npos), m_compare(compare) {}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline size_t Indexed_priority_queue<T_Priority, T_Compare, D>::Top() const
+	{
+		if (m_heap.Empty()) throw "top of empty priority queue";
+		return m_heap[0].id;
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline const T_Priority& Indexed_priority_queue<T_Priority, T_Compare, D>::Top_priority() const
+	{
+		if (m_heap.Empty()) throw "top of empty priority queue";
+		return m_heap[0].priority;
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline const T_Priority& Indexed_priority_queue<T_Priority, T_Compare, D>::Priority(size_t id) const
+	{
+		if (!Contains(id)) throw "id not in priority queue";
+		return m_heap[m_position[id]].priority;
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::Reserve_ids(size_t capacity)
+	{
+		if (capacity > m_position.Size())
+			m_position.Resize(capacity, npos);
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::Push(size_t id, const T_Priority& priority)
+	{
+		if (id >= m_position.Size()) Reserve_ids(Max(id + 1, m_position.Size() * 2));
+		if (m_position[id] != npos) throw "id already in priority queue";
+
+		Entry entry{ priority, id };
+		m_heap.Push_back(entry);
+		siftUp(m_heap.Size() - 1, entry);
+	}
+
+	//the new priority must not be served later than the current one
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::Decrease_key(size_t id, const T_Priority& priority)
+	{
+		if (!Contains(id)) throw "id not in priority queue";
+
+		size_t hole = m_position[id];
+		if (m_compare(m_heap[hole].priority, priority)) throw "decrease key to a later priority";
+
+		Entry entry{ priority, id };
+		siftUp(hole, entry);
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::Update(size_t id, const T_Priority& priority)
+	{
+		if (!Contains(id)) throw "id not in priority queue";
+
+		size_t hole = m_position[id];
+		bool earlier = m_compare(priority, m_heap[hole].priority);
+
+		Entry entry{ priority, id };
+		if (earlier)
+			siftUp(hole, entry);
+		else
+			siftDown(hole, entry);
+	}
+
+	//relaxation step of a shortest path search, returns whether the id was pushed or improved
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline bool Indexed_priority_queue<T_Priority, T_Compare, D>::Push_or_decrease(size_t id, const T_Priority& priority)
+	{
+		if (!Contains(id))
+		{
+			Push(id, priority);
+			return true;
+		}
+
+		size_t hole = m_position[id];
+		if (!m_compare(priority, m_heap[hole].priority)) return false;
+
+		Entry entry{ priority, id };
+		siftUp(hole, entry);
+		return true;
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::Pop()
+	{
+		if (m_heap.Empty()) throw "pop empty priority queue";
+		Erase(m_heap[0].id);
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::Erase(size_t id)
+	{
+		if (!Contains(id)) throw "id not in priority queue";
+
+		size_t hole = m_position[id];
+		m_position[id] = npos;
+
+		Entry last = Move(m_heap.Back());
+		m_heap.Pop_back();
+		if (hole == m_heap.Size()) return;
+
+		if (m_compare(last.priority, m_heap[hole].priority))
+			siftUp(hole, last);
+		else
+			siftDown(hole, last);
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::Clear()
+	{
+		for (size_t i = 0; i < m_heap.Size(); ++i)
+			m_position[m_heap[i].id] = npos;
+
+		m_heap.Clear();
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::siftUp(size_t hole, Entry& entry)
+	{
+		while (hole > 0)
+		{
+			size_t parent = (hole - 1) / D;
+			if (!m_compare(entry.priority, m_heap[parent].priority)) break;
+
+			place(hole, m_heap[parent]);
+			hole = parent;
+		}
+
+		place(hole, entry);
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::siftDown(size_t hole, Entry& entry)
+	{
+		size_t size = m_heap.Size();
+
+		while (true)
+		{
+			size_t child = hole * D + 1;
+			if (child >= size) break;
+
+			size_t best = child;
+			size_t end = Min(child + D, size);
+			for (++child; child < end; ++child)
+				if (m_compare(m_heap[child].priority, m_heap[best].priority))
+					best = child;
+
+			if (!m_compare(m_heap[best].priority, entry.priority)) break;
+
+			place(hole, m_heap[best]);
+			hole = best;
+		}
+
+		place(hole, entry);
+	}
+
+	template<typename T_Priority, typename T_Compare, size_t D>
+	inline void Indexed_priority_queue<T_Priority, T_Compare, D>::place(size_t hole, Entry& entry)
+	{
+		m_position[entry.id] = hole;
+		m_heap[hole] = Move(entry);
+	}
+}
+
+#endif // !DVTL_PRIORITY_QUEUE_H
@@ -0,0 +1,361 @@
+#ifndef DVTL_RANDOM_H
+#define DVTL_RANDOM_H
+
+#include <cmath>
+
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace DVTL
+{
+	//generators are small value types producing every bit pattern of result_type with equal probability,
+	//result_type, Min() and Max() let them drive std distributions as well
+
+	//splitmix64, mostly used to expand one seed into the state of the other generators
+	class Splitmix64
+	{
+	public:
+		typedef unsigned long long result_type;
+
+		explicit Splitmix64(unsigned long long seed = 0) :m_state(seed) {}
+
+		static constexpr result_type Min() { return 0; }
+		static constexpr result_type Max() { return ~0ull; }
+
+		result_type operator()()
+		{
+			unsigned long long z = (m_state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+	private:
+		unsigned long long m_state;
+	};
+
+	//xoshiro256**, the default 64-bit generator; Jump() advances 2^128 steps to split streams between threads
+	class Xoshiro256ss
+	{
+	public:
+		typedef unsigned long long result_type;
+
+		explicit Xoshiro256ss(unsigned long long seed = 0)
+		{
+			Splitmix64 expand(seed);
+			for (size_t i = 0; i < 4; ++i)
+				m_state[i] = expand();
+		}
+
+		static constexpr result_type Min() { return 0; }
+		static constexpr result_type Max() { return ~0ull; }
+
+		result_type operator()()
+		{
+			unsigned long long result = rotate(m_state[1] * 5, 7) * 9;
+			unsigned long long shifted = m_state[1] << 17;
+
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= shifted;
+			m_state[3] = rotate(m_state[3], 45);
+
+			return result;
+		}
+
+		void Jump()
+		{
+			static constexpr unsigned long long jump[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+			unsigned long long state[4] = { 0, 0, 0, 0 };
+
+			for (size_t i = 0; i < 4; ++i)
+			{
+				for (size_t bit = 0; bit < 64; ++bit)
+				{
+					if (jump[i] & (1ull << bit))
+						for (size_t j = 0; j < 4; ++j)
+							state[j] ^= m_state[j];
+
+					(*this)();
+				}
+			}
+
+			for (size_t i = 0; i < 4; ++i)
+				m_state[i] = state[i];
+		}
+	private:
+		unsigned long long m_state[4];
+
+		static unsigned long long rotate(unsigned long long value, int shift) { return (value << shift) | (value >> (64 - shift)); }
+	};
+
+	//PCG32 (XSH RR), a 32-bit generator with 64-bit state; generators on different streams never overlap
+	class Pcg32
+	{
+	public:
+		typedef unsigned int result_type;
+
+		explicit Pcg32(unsigned long long seed = 0, unsigned long long stream = 0x14057B7EF767814Full) :m_state(0), m_increment((stream << 1) | 1)
+		{
+			(*this)();
+			m_state += seed;
+			(*this)();
+		}
+
+		static constexpr result_type Min() { return 0; }
+		static constexpr result_type Max() { return ~0u; }
+
+		result_type operator()()
+		{
+			unsigned long long state = m_state;
+			m_state = state * 0x5851F42D4C957F2Dull + m_increment;
+
+			unsigned int xorshifted = static_cast<unsigned int>(((state >> 18) ^ state) >> 27);
+			unsigned int rotation = static_cast<unsigned int>(state >> 59);
+			return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31));
+		}
+	private:
+		unsigned long long m_state;
+		unsigned long long m_increment;
+	};
+
+	namespace Detail
+	{
+		template<typename T_Generator>
+		inline unsigned long long next64(T_Generator& generator, True_type) { return static_cast<unsigned long long>(generator()); }
+
+		template<typename T_Generator>
+		inline unsigned long long next64(T_Generator& generator, False_type)
+		{
+			unsigned long long high = static_cast<unsigned long long>(generator());
+			return (high << 32) | static_cast<unsigned long long>(generator());
+		}
+
+		template<typename T_Generator>
+		inline unsigned long long next64(T_Generator& generator)
+		{
+			return next64(generator, Bool_constant<sizeof(typename T_Generator::result_type) >= 8>());
+		}
+
+		template<typename T_Generator>
+		inline unsigned int next32(T_Generator& generator)
+		{
+			return static_cast<unsigned int>(static_cast<unsigned long long>(generator()) >> (sizeof(typename T_Generator::result_type) >= 8 ? 32 : 0));
+		}
+
+		//two bounded values from one 64-bit draw, range1 * range2 must fit in 64 bits
+		template<typename T_Generator>
+		inline void boundedPair(T_Generator& generator, unsigned long long range1, unsigned long long range2, unsigned long long& result1, unsigned long long& result2)
+		{
+			unsigned long long product = range1 * range2;
+			unsigned long long threshold = 0;
+
+			while (true)
+			{
+				unsigned long long leftover;
+				result1 = multiplyWide(next64(generator), range1, leftover);
+				result2 = multiplyWide(leftover, range2, leftover);
+
+				if (leftover >= product) return;
+
+				if (threshold == 0)
+					threshold = (0 - product) % product;
+				if (leftover >= threshold) return;
+			}
+		}
+
+		//uniform double in the open interval (0, 1)
+		template<typename T_Generator>
+		inline double openUnit(T_Generator& generator)
+		{
+			return (static_cast<double>(next64(generator) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+		}
+	}
+
+	//Lemire's nearly divisionless method: uniform in [0, range) without bias,
+	//the modulo is only computed for the rare draws that land in the biased low region
+	template<typename T_Generator>
+	inline unsigned long long Bounded_random(T_Generator& generator, unsigned long long range)
+	{
+		if (range == 0) throw "bounded random with empty range";
+
+		if (range <= 0xFFFFFFFFull)
+		{
+			unsigned int bound = static_cast<unsigned int>(range);
+			unsigned long long product = static_cast<unsigned long long>(Detail::next32(generator)) * bound;
+			unsigned int low = static_cast<unsigned int>(product);
+
+			if (low < bound)
+			{
+				unsigned int threshold = (0u - bound) % bound;
+				while (low < threshold)
+				{
+					product = static_cast<unsigned long long>(Detail::next32(generator)) * bound;
+					low = static_cast<unsigned int>(product);
+				}
+			}
+
+			return product >> 32;
+		}
+
+		unsigned long long low;
+		unsigned long long high = Detail::multiplyWide(Detail::next64(generator), range, low);
+
+		if (low < range)
+		{
+			unsigned long long threshold = (0 - range) % range;
+			while (low < threshold)
+				high = Detail::multiplyWide(Detail::next64(generator), range, low);
+		}
+
+		return high;
+	}
+
+	//uniform in [low, high]
+	template<typename T_Generator>
+	inline long long Bounded_random(T_Generator& generator, long long low, long long high)
+	{
+		if (high < low) throw "bounded random with empty range";
+
+		unsigned long long range = static_cast<unsigned long long>(high) - static_cast<unsigned long long>(low) + 1;
+		unsigned long long offset = range == 0 ? Detail::next64(generator) : Bounded_random(generator, range);
+		return static_cast<long long>(static_cast<unsigned long long>(low) + offset);
+	}
+
+	//Fisher-Yates drawing two swap positions per 64-bit random value while the bounds allow it
+	template<typename T_Iterator, typename T_Generator>
+	inline void Shuffle(T_Iterator first, T_Iterator last, T_Generator& generator)
+	{
+		unsigned long long remaining = static_cast<unsigned long long>(last - first);
+
+		while (remaining > (1ull << 30))
+		{
+			unsigned long long index = Bounded_random(generator, remaining);
+			--remaining;
+			Iter_swap(first + remaining, first + index);
+		}
+
+		while (remaining > 1)
+		{
+			unsigned long long index1, index2;
+			Detail::boundedPair(generator, remaining, remaining - 1, index1, index2);
+
+			Iter_swap(first + (remaining - 1), first + index1);
+			Iter_swap(first + (remaining - 2), first + index2);
+			remaining -= 2;
+		}
+	}
+
+	//reservoir sampling with Algorithm L: count elements chosen uniformly from a single pass,
+	//after the reservoir fills only O(count log(n / count)) random values are drawn;
+	//result must be random access, the order of the sample is not uniform, returns the sample size
+	template<typename T_Iterator, typename T_IteratorOutput, typename T_Generator>
+	inline size_t Sample(T_Iterator first, T_Iterator last, T_IteratorOutput result, size_t count, T_Generator& generator)
+	{
+		size_t size = 0;
+		for (; first != last && size < count; ++first, ++size)
+			result[size] = *first;
+
+		if (first == last || count == 0) return size;
+
+		double weight = std::exp(std::log(Detail::openUnit(generator)) / static_cast<double>(count));
+
+		while (true)
+		{
+			double skip = std::floor(std::log(Detail::openUnit(generator)) / std::log1p(-weight));
+
+			for (; skip > 0 && first != last; skip -= 1)
+				++first;
+
+			if (first == last) return size;
+
+			result[Bounded_random(generator, count)] = *first;
+			++first;
+			weight *= std::exp(std::log(Detail::openUnit(generator)) / static_cast<double>(count));
+		}
+	}
+
+	//streaming reservoir over elements pushed one at a time, Algorithm L keeps the skip between pushes
+	template<typename T, typename T_Generator = Xoshiro256ss>
+	class Reservoir_sampler
+	{
+	public:
+		//constructors
+		explicit Reservoir_sampler(size_t count, const T_Generator& generator = T_Generator());
+
+		//getting sampler data
+		inline const Vector<T>&		Sample()	const noexcept { return m_sample; }
+		inline unsigned long long	Seen()		const noexcept { return m_seen; }
+
+		//adding elements
+		void Push(const T& value);
+		template<typename T_Iterator> void Push(T_Iterator first, T_Iterator last);
+		void Clear();
+	private:
+		Vector<T> m_sample;
+		size_t m_count;
+		unsigned long long m_seen;
+		unsigned long long m_next;
+		double m_weight;
+		T_Generator m_generator;
+
+		void scheduleNext();
+	};
+
+	template<typename T, typename T_Generator>
+	inline Reservoir_sampler<T, T_Generator>::Reservoir_sampler(size_t count, const T_Generator& generator)
+		:m_sample(), m_count(count), m_seen(0), m_next(0), m_weight(0), m_generator(generator)
+	{
+		m_sample.Reserve(count);
+	}
+
+	template<typename T, typename T_Generator>
+	inline void Reservoir_sampler<T, T_Generator>::Push(const T& value)
+	{
+		++m_seen;
+
+		if (m_sample.Size() < m_count)
+		{
+			m_sample.Push_back(value);
+
+			if (m_sample.Size() == m_count)
+			{
+				m_weight = std::exp(std::log(Detail::openUnit(m_generator)) / static_cast<double>(m_count));
+				scheduleNext();
+			}
+		}
+		else if (m_count != 0 && m_seen == m_next)
+		{
+			m_sample[Bounded_random(m_generator, m_count)] = value;
+			m_weight *= std::exp(std::log(Detail::openUnit(m_generator)) / static_cast<double>(m_count));
+			scheduleNext();
+		}
+	}
+
+	template<typename T, typename T_Generator>
+	template<typename T_Iterator>
+	inline void Reservoir_sampler<T, T_Generator>::Push(T_Iterator first, T_Iterator last)
+	{
+		for (; first != last; ++first)
+			Push(*first);
+	}
+
+	template<typename T, typename T_Generator>
+	inline void Reservoir_sampler<T, T_Generator>::Clear()
+	{
+		m_sample.Clear();
+		m_seen = 0;
+		m_next = 0;
+	}
+
+	//m_next is the 1-based position of the next element to replace
+	template<typename T, typename T_Generator>
+	inline void Reservoir_sampler<T, T_Generator>::scheduleNext()
+	{
+		double skip = std::floor(std::log(Detail::openUnit(m_generator)) / std::log1p(-m_weight));
+		m_next = skip >= 1e18 ? ~0ull : m_seen + static_cast<unsigned long long>(skip) + 1;
+	}
+}
+
+#endif // !DVTL_RANDOM_H
@@ -0,0 +1,347 @@
+#ifndef DVTL_SKETCH_H
+#define DVTL_SKETCH_H
+
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace DVTL
+{
+	//keeps the k greatest elements by T_Compare in O(k) memory,
+	//the least retained element sits on top of a 4-ary heap so most rejects cost one comparison
+	template<typename T, typename T_Compare = Less_than<T>>
+	class Top_k
+	{
+	public:
+		//constructors
+		explicit Top_k(size_t k, const T_Compare& compare = T_Compare());
+
+		//getting accumulator data
+		inline size_t	Size()	const noexcept { return m_heap.Size(); }
+		inline size_t	K()		const noexcept { return m_k; }
+		inline bool		Empty()	const noexcept { return m_heap.Empty(); }
+		const T& Threshold() const;
+		Vector<T> Sorted() const;
+
+		//adding elements
+		void Push(const T& value);
+		void Push(T&& value);
+		template<typename T_Iterator> void Push(T_Iterator first, T_Iterator last);
+		void Merge(const Top_k& right);
+		void Clear();
+	private:
+		Vector<T> m_heap;
+		size_t m_k;
+		T_Compare m_compare;
+
+		bool accepts(const T& value) const;
+		void replaceTop(T& value);
+	};
+
+	//KLL quantile sketch: level h holds items of weight 2^h, a full level is sorted and every other item
+	//is promoted to the next level from a random offset; capacities shrink by 2/3 below the top level,
+	//so memory stays around 3k items and ranks are off by about n / k;
+	//sketches of the same k merge level by level, so per-thread instances can be combined at read time
+	template<typename T, typename T_Compare = Less_than<T>>
+	class Quantile_sketch
+	{
+	public:
+		//constructors
+		explicit Quantile_sketch(size_t k = 200, unsigned long long seed = 0x9E3779B97F4A7C15ull, const T_Compare& compare = T_Compare());
+
+		//getting sketch data
+		inline unsigned long long	Count()	const noexcept { return m_count; }
+		inline bool					Empty()	const noexcept { return m_count == 0; }
+		size_t Retained() const;
+		T Quantile(double fraction) const;
+		double Rank(const T& value) const;
+
+		//adding elements
+		void Push(const T& value);
+		template<typename T_Iterator> void Push(T_Iterator first, T_Iterator last);
+		void Merge(const Quantile_sketch& right);
+		void Clear();
+	private:
+		Vector<Vector<T>> m_levels;
+		size_t m_k;
+		size_t m_retained;
+		size_t m_capacity;
+		unsigned long long m_count;
+		unsigned long long m_random;
+		T_Compare m_compare;
+
+		size_t levelCapacity(size_t level) const;
+		void grow();
+		void compress();
+		bool coin();
+		Vector<Pair<T, unsigned long long>> weighted() const;
+	};
+
+	//Top_k
+
+	template<typename T, typename T_Compare>
+	inline Top_k<T, T_Compare>::Top_k(size_t k, const T_Compare& compare) :m_heap(), m_k(k), m_compare(compare)
+	{
+		m_heap.Reserve(k);
+	}
+
+	template<typename T, typename T_Compare>
+	inline const T& Top_k<T, T_Compare>::Threshold() const
+	{
+		if (m_heap.Empty()) throw "threshold of empty top k";
+		return m_heap.Front();
+	}
+
+	//greatest first
+	template<typename T, typename T_Compare>
+	inline Vector<T> Top_k<T, T_Compare>::Sorted() const
+	{
+		Vector<T> result(m_heap);
+		T_Compare compare = m_compare;
+		Sort(result.Begin(), result.End(), [&compare](const T& left, const T& right) { return compare(right, left); });
+		return result;
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Top_k<T, T_Compare>::Push(const T& value)
+	{
+		if (m_heap.Size() < m_k)
+		{
+			m_heap.Push_back(value);
+			Push_heap_d<4>(m_heap.Begin(), m_heap.End(), m_compare);
+		}
+		else if (accepts(value))
+		{
+			T entry(value);
+			replaceTop(entry);
+		}
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Top_k<T, T_Compare>::Push(T&& value)
+	{
+		if (m_heap.Size() < m_k)
+		{
+			m_heap.Push_back(Move(value));
+			Push_heap_d<4>(m_heap.Begin(), m_heap.End(), m_compare);
+		}
+		else if (accepts(value))
+			replaceTop(value);
+	}
+
+	//a batch fills the heap without sifting and heapifies once
+	template<typename T, typename T_Compare>
+	template<typename T_Iterator>
+	inline void Top_k<T, T_Compare>::Push(T_Iterator first, T_Iterator last)
+	{
+		if (m_heap.Size() < m_k)
+		{
+			for (; first != last && m_heap.Size() < m_k; ++first)
+				m_heap.Push_back(*first);
+
+			Make_heap_d<4>(m_heap.Begin(), m_heap.End(), m_compare);
+		}
+
+		for (; first != last; ++first)
+			Push(*first);
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Top_k<T, T_Compare>::Merge(const Top_k& right)
+	{
+		Push(right.m_heap.Begin(), right.m_heap.End());
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Top_k<T, T_Compare>::Clear()
+	{
+		m_heap.Clear();
+	}
+
+	template<typename T, typename T_Compare>
+	inline bool Top_k<T, T_Compare>::accepts(const T& value) const
+	{
+		return m_k != 0 && m_compare(m_heap.Front(), value);
+	}
+
+	//the least retained element is dropped and value sifts down from its place
+	template<typename T, typename T_Compare>
+	inline void Top_k<T, T_Compare>::replaceTop(T& value)
+	{
+		Detail::siftDownD<4>(m_heap.Begin(), m_heap.Size(), 0, value, m_compare);
+	}
+
+	//Quantile_sketch
+
+	template<typename T, typename T_Compare>
+	inline Quantile_sketch<T, T_Compare>::Quantile_sketch(size_t k, unsigned long long seed, const T_Compare& compare)
+		:m_levels(), m_k(Max<size_t>(k, 8)), m_retained(0), m_capacity(0), m_count(0), m_random(seed | 1), m_compare(compare)
+	{
+		grow();
+	}
+
+	template<typename T, typename T_Compare>
+	inline size_t Quantile_sketch<T, T_Compare>::Retained() const
+	{
+		return m_retained;
+	}
+
+	//smallest retained item whose weighted rank reaches fraction of the count
+	template<typename T, typename T_Compare>
+	inline T Quantile_sketch<T, T_Compare>::Quantile(double fraction) const
+	{
+		if (m_count == 0) throw "quantile of empty sketch";
+
+		Vector<Pair<T, unsigned long long>> items = weighted();
+		double target = fraction * static_cast<double>(m_count);
+		unsigned long long rank = 0;
+
+		for (size_t i = 0; i < items.Size(); ++i)
+		{
+			rank += items[i].Second;
+			if (static_cast<double>(rank) >= target) return items[i].First;
+		}
+
+		return items.Back().First;
+	}
+
+	//estimated fraction of pushed elements less than value
+	template<typename T, typename T_Compare>
+	inline double Quantile_sketch<T, T_Compare>::Rank(const T& value) const
+	{
+		if (m_count == 0) throw "rank of empty sketch";
+
+		unsigned long long rank = 0;
+		for (size_t level = 0; level < m_levels.Size(); ++level)
+			for (size_t i = 0; i < m_levels[level].Size(); ++i)
+				if (m_compare(m_levels[level][i], value))
+					rank += 1ull << level;
+
+		return static_cast<double>(rank) / static_cast<double>(m_count);
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Quantile_sketch<T, T_Compare>::Push(const T& value)
+	{
+		m_levels[0].Push_back(value);
+		++m_count;
+
+		if (++m_retained >= m_capacity)
+			compress();
+	}
+
+	template<typename T, typename T_Compare>
+	template<typename T_Iterator>
+	inline void Quantile_sketch<T, T_Compare>::Push(T_Iterator first, T_Iterator last)
+	{
+		for (; first != last; ++first)
+			Push(*first);
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Quantile_sketch<T, T_Compare>::Merge(const Quantile_sketch& right)
+	{
+		if (right.m_k != m_k) throw "merge of sketches with different k";
+
+		while (m_levels.Size() < right.m_levels.Size())
+			grow();
+
+		for (size_t level = 0; level < right.m_levels.Size(); ++level)
+			for (size_t i = 0; i < right.m_levels[level].Size(); ++i)
+				m_levels[level].Push_back(right.m_levels[level][i]);
+
+		m_count += right.m_count;
+		m_retained += right.m_retained;
+
+		while (m_retained >= m_capacity)
+			compress();
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Quantile_sketch<T, T_Compare>::Clear()
+	{
+		m_levels.Clear();
+		m_retained = 0;
+		m_capacity = 0;
+		m_count = 0;
+		grow();
+	}
+
+	template<typename T, typename T_Compare>
+	inline size_t Quantile_sketch<T, T_Compare>::levelCapacity(size_t level) const
+	{
+		double capacity = static_cast<double>(m_k);
+		for (size_t depth = m_levels.Size() - level - 1; depth > 0; --depth)
+			capacity *= 2.0 / 3.0;
+
+		return static_cast<size_t>(capacity) + 2;
+	}
+
+	template<typename T, typename T_Compare>
+	inline void Quantile_sketch<T, T_Compare>::grow()
+	{
+		m_levels.Emplace_back();
+
+		m_capacity = 0;
+		for (size_t level = 0; level < m_levels.Size(); ++level)
+			m_capacity += levelCapacity(level);
+	}
+
+	//compacts the lowest full level
+	template<typename T, typename T_Compare>
+	inline void Quantile_sketch<T, T_Compare>::compress()
+	{
+		for (size_t level = 0; level < m_levels.Size(); ++level)
+		{
+			if (m_levels[level].Size() < levelCapacity(level)) continue;
+
+			if (level + 1 == m_levels.Size())
+				grow();
+
+			Vector<T>& items = m_levels[level];
+			Vector<T>& next = m_levels[level + 1];
+			Sort(items.Begin(), items.End(), m_compare);
+
+			//an odd item out stays at this level
+			size_t pairs = items.Size() / 2;
+			size_t offset = coin() ? 1 : 0;
+			for (size_t i = 0; i < pairs; ++i)
+				next.Push_back(Move(items[offset + i * 2]));
+
+			if (items.Size() % 2 != 0)
+				items[0] = Move(items.Back());
+
+			size_t keep = items.Size() % 2;
+			while (items.Size() > keep)
+				items.Pop_back();
+
+			m_retained -= pairs;
+			return;
+		}
+	}
+
+	template<typename T, typename T_Compare>
+	inline bool Quantile_sketch<T, T_Compare>::coin()
+	{
+		m_random ^= m_random << 13;
+		m_random ^= m_random >> 7;
+		m_random ^= m_random << 17;
+		return (m_random >> 63) != 0;
+	}
+
+	template<typename T, typename T_Compare>
+	inline Vector<Pair<T, unsigned long long>> Quantile_sketch<T, T_Compare>::weighted() const
+	{
+		Vector<Pair<T, unsigned long long>> items;
+		items.Reserve(m_retained);
+
+		for (size_t level = 0; level < m_levels.Size(); ++level)
+			for (size_t i = 0; i < m_levels[level].Size(); ++i)
+				items.Emplace_back(m_levels[level][i], 1ull << level);
+
+		T_Compare compare = m_compare;
+		Sort(items.Begin(), items.End(), [&compare](const Pair<T, unsigned long long>& left, const Pair<T, unsigned long long>& right) { return compare(left.First, right.First); });
+		return items;
+	}
+}
+
+#endif // !DVTL_SKETCH_H
@@ -0,0 +1,119 @@
+#ifndef DVTL_STATIC_SORTED_TABLE_H
+#define DVTL_STATIC_SORTED_TABLE_H
+
+#include "Algorithm.h"
+
+namespace DVTL
+{
+	namespace Detail
+	{
+		template<typename T_Key, typename T_Value, typename T_Compare>
+		struct Entry_compare
+		{
+			T_Compare compare;
+
+			constexpr bool operator()(const Pair<T_Key, T_Value>& left, const Pair<T_Key, T_Value>& right) const { return compare(left.First, right.First); }
+		};
+	}
+
+	//read-only table of N unique keys sorted when it is built, so a constexpr table costs nothing at startup;
+	//keys and values live in separate arrays and lookups are a fixed number of conditional moves
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare = Less_than<T_Key>>
+	class Static_sorted_table
+	{
+		static_assert(N > 0, "static sorted table needs at least one entry");
+	public:
+		//constructors
+		constexpr explicit Static_sorted_table(const Pair<T_Key, T_Value>(&entries)[N], const T_Compare& compare = T_Compare());
+
+		//getting table data
+		static constexpr size_t Size() noexcept { return N; }
+		constexpr const T_Key&		Key(size_t index)	const { return m_keys[index]; }
+		constexpr const T_Value&	Value(size_t index)	const { return m_values[index]; }
+		constexpr const T_Key*		Keys()				const noexcept { return m_keys; }
+		constexpr const T_Value*	Values()			const noexcept { return m_values; }
+
+		//lookups
+		constexpr size_t Lower_bound(const T_Key& key) const;
+		constexpr size_t Index_of(const T_Key& key) const;
+		constexpr bool Contains(const T_Key& key) const;
+		constexpr const T_Value* Find(const T_Key& key) const;
+		constexpr const T_Value& At(const T_Key& key) const;
+	private:
+		T_Key m_keys[N];
+		T_Value m_values[N];
+		T_Compare m_compare;
+	};
+
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare>
+	constexpr Static_sorted_table<T_Key, T_Value, N, T_Compare>::Static_sorted_table(const Pair<T_Key, T_Value>(&entries)[N], const T_Compare& compare)
+		:m_keys(), m_values(), m_compare(compare)
+	{
+		Pair<T_Key, T_Value> sorted[N] = {};
+		for (size_t i = 0; i < N; ++i)
+			sorted[i] = entries[i];
+
+		Sort(sorted, sorted + N, Detail::Entry_compare<T_Key, T_Value, T_Compare>{ compare });
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			m_keys[i] = sorted[i].First;
+			m_values[i] = sorted[i].Second;
+		}
+	}
+
+	//the loop count depends only on N, the compiler unrolls it into compares and conditional moves
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare>
+	constexpr size_t Static_sorted_table<T_Key, T_Value, N, T_Compare>::Lower_bound(const T_Key& key) const
+	{
+		size_t first = 0;
+
+		for (size_t length = N; length > 1; length -= length / 2)
+			first += m_compare(m_keys[first + length / 2], key) ? length / 2 : 0;
+
+		return first + (m_compare(m_keys[first], key) ? 1 : 0);
+	}
+
+	//N when the key is absent
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare>
+	constexpr size_t Static_sorted_table<T_Key, T_Value, N, T_Compare>::Index_of(const T_Key& key) const
+	{
+		size_t index = Lower_bound(key);
+		return index != N && !m_compare(key, m_keys[index]) ? index : N;
+	}
+
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare>
+	constexpr bool Static_sorted_table<T_Key, T_Value, N, T_Compare>::Contains(const T_Key& key) const
+	{
+		return Index_of(key) != N;
+	}
+
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare>
+	constexpr const T_Value* Static_sorted_table<T_Key, T_Value, N, T_Compare>::Find(const T_Key& key) const
+	{
+		size_t index = Index_of(key);
+		return index != N ? m_values + index : nullptr;
+	}
+
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare>
+	constexpr const T_Value& Static_sorted_table<T_Key, T_Value, N, T_Compare>::At(const T_Key& key) const
+	{
+		size_t index = Index_of(key);
+		if (index == N) throw "key not in static sorted table";
+		return m_values[index];
+	}
+
+	template<typename T_Key, typename T_Value, size_t N>
+	constexpr Static_sorted_table<T_Key, T_Value, N> Make_static_sorted_table(const Pair<T_Key, T_Value>(&entries)[N])
+	{
+		return Static_sorted_table<T_Key, T_Value, N>(entries);
+	}
+
+	template<typename T_Key, typename T_Value, size_t N, typename T_Compare>
+	constexpr Static_sorted_table<T_Key, T_Value, N, T_Compare> Make_static_sorted_table(const Pair<T_Key, T_Value>(&entries)[N], const T_Compare& compare)
+	{
+		return Static_sorted_table<T_Key, T_Value, N, T_Compare>(entries, compare);
+	}
+}
+
+#endif // !DVTL_STATIC_SORTED_TABLE_H
@@ -1,7 +1,7 @@
 #ifndef DVTL_UNIQUE_PTR_H
 #define DVTL_UNIQUE_PTR_H
 
-#include "utility.h"
+#include "Utility.h"
 
 namespace DVTL 
 {
@@ -0,0 +1,153 @@
+#ifndef DVTL_UTILITY_H
+#define DVTL_UTILITY_H
+
+#include <cstddef>
+#include <new>
+
+namespace DVTL
+{
+	template<typename T> struct Remove_reference		{ typedef T type; };
+	template<typename T> struct Remove_reference<T&>	{ typedef T type; };
+	template<typename T> struct Remove_reference<T&&>	{ typedef T type; };
+
+	template<typename T> using Remove_reference_t = typename Remove_reference<T>::type;
+
+	template<typename T> struct Remove_cv						{ typedef T type; };
+	template<typename T> struct Remove_cv<const T>				{ typedef T type; };
+	template<typename T> struct Remove_cv<volatile T>			{ typedef T type; };
+	template<typename T> struct Remove_cv<const volatile T>	{ typedef T type; };
+
+	template<typename T> using Remove_cvref_t = typename Remove_cv<Remove_reference_t<T>>::type;
+
+	template<bool Condition, typename T = void> struct Enable_if {};
+	template<typename T> struct Enable_if<true, T> { typedef T type; };
+
+	template<bool Condition, typename T = void> using Enable_if_t = typename Enable_if<Condition, T>::type;
+
+	template<typename T1, typename T2> constexpr bool Is_same_v = false;
+	template<typename T> constexpr bool Is_same_v<T, T> = true;
+
+	template<bool Value> struct Bool_constant { static constexpr bool value = Value; };
+	typedef Bool_constant<true>		True_type;
+	typedef Bool_constant<false>	False_type;
+
+	template<typename...> using Void_t = void;
+
+	template<typename T> T&& Declval() noexcept;
+
+	template<typename T> constexpr bool Is_arithmetic_base_v = false;
+	template<> constexpr bool Is_arithmetic_base_v<bool> = true;
+	template<> constexpr bool Is_arithmetic_base_v<char> = true;
+	template<> constexpr bool Is_arithmetic_base_v<signed char> = true;
+	template<> constexpr bool Is_arithmetic_base_v<unsigned char> = true;
+	template<> constexpr bool Is_arithmetic_base_v<wchar_t> = true;
+	template<> constexpr bool Is_arithmetic_base_v<char16_t> = true;
+	template<> constexpr bool Is_arithmetic_base_v<char32_t> = true;
+	template<> constexpr bool Is_arithmetic_base_v<short> = true;
+	template<> constexpr bool Is_arithmetic_base_v<unsigned short> = true;
+	template<> constexpr bool Is_arithmetic_base_v<int> = true;
+	template<> constexpr bool Is_arithmetic_base_v<unsigned int> = true;
+	template<> constexpr bool Is_arithmetic_base_v<long> = true;
+	template<> constexpr bool Is_arithmetic_base_v<unsigned long> = true;
+	template<> constexpr bool Is_arithmetic_base_v<long long> = true;
+	template<> constexpr bool Is_arithmetic_base_v<unsigned long long> = true;
+	template<> constexpr bool Is_arithmetic_base_v<float> = true;
+	template<> constexpr bool Is_arithmetic_base_v<double> = true;
+	template<> constexpr bool Is_arithmetic_base_v<long double> = true;
+
+	template<typename T> constexpr bool Is_arithmetic_v = Is_arithmetic_base_v<typename Remove_cv<T>::type>;
+
+#if defined(__GNUC__) && !defined(__clang__)
+	template<typename T> constexpr bool Is_trivially_destructible_v = __has_trivial_destructor(T);
+#else
+	template<typename T> constexpr bool Is_trivially_destructible_v = __is_trivially_destructible(T);
+#endif
+
+	template<typename T> constexpr bool Is_lvalue_reference_v = false;
+	template<typename T> constexpr bool Is_lvalue_reference_v<T&> = true;
+
+	template<typename T> constexpr Remove_reference_t<T>&& Move(T&& obj) noexcept	{ return static_cast<Remove_reference_t<T>&&>(obj); }
+	template<typename T> constexpr T&& Forward(Remove_reference_t<T>& obj) noexcept { return static_cast<T&&>(obj); }
+	template<typename T> constexpr T&& Forward(Remove_reference_t<T>&& obj) noexcept
+	{
+		static_assert(!Is_lvalue_reference_v<T>, "bad forward call");
+		return static_cast<T&&>(obj);
+	}
+
+	template<typename T> struct Less_than		{ constexpr bool operator()(const T& left, const T& right) const { return left < right; } };
+	template<typename T> struct Greater_than	{ constexpr bool operator()(const T& left, const T& right) const { return left > right; } };
+	template<typename T> struct Equal_to		{ constexpr bool operator()(const T& left, const T& right) const { return left == right; } };
+
+	struct In_place_t { explicit In_place_t() = default; };
+	constexpr In_place_t In_place{};
+
+	template<typename T1, typename T2>
+	struct Pair {
+		T1 First;
+		T2 Second;
+
+		constexpr Pair() :First(T1()), Second(T2()) {};
+		constexpr Pair(const T1& val1, const T2& val2) :First(val1), Second(val2) {};
+		template<typename U1, typename U2> constexpr Pair(const Pair<U1, U2>& right) :First(right.First), Second(right.Second) {};
+		template<typename U1, typename U2> constexpr Pair(Pair<U1, U2>&& right) :First(Forward<U1>(right.First)), Second(Forward<U2>(right.Second)) {};
+		template<typename U1, typename U2, typename = Enable_if_t<!Is_same_v<Remove_cvref_t<U1>, In_place_t>>>
+		constexpr Pair(U1&& val1, U2&& val2) :First(Forward<U1>(val1)), Second(Forward<U2>(val2)) {};
+		template<typename U1, typename... Types>
+		constexpr Pair(In_place_t, U1&& val1, Types&&... args) :First(Forward<U1>(val1)), Second(Forward<Types>(args)...) {};
+		Pair(const Pair&) = default;
+		Pair(Pair&&) = default;
+
+		Pair& operator=(const Pair&) = default;
+		Pair& operator=(Pair&&) = default;
+		template<typename U1, typename U2> Pair& operator=(const Pair<U1, U2>& right);
+		template<typename U1, typename U2> Pair& operator=(Pair<U1, U2>&& right);
+
+		~Pair() = default;
+
+		void Swap(Pair& p);
+	};
+
+	template<typename T1, typename T2>
+	template<typename U1, typename U2>
+	inline Pair<T1, T2>& Pair<T1, T2>::operator=(const Pair<U1, U2>& right)
+	{
+		First = right.First;
+		Second = right.Second;
+
+		return *this;
+	}
+
+	template<typename T1, typename T2>
+	template<typename U1, typename U2>
+	inline Pair<T1, T2>& Pair<T1, T2>::operator=(Pair<U1, U2>&& right)
+	{
+		First = Forward<U1>(right.First);
+		Second = Forward<U2>(right.Second);
+
+		return *this;
+	}
+
+	template<typename T1, typename T2>
+	inline void Pair<T1, T2>::Swap(Pair& p)
+	{
+		T1 temp_f(Move(p.First));
+		p.First = Move(First);
+		First = Move(temp_f);
+
+		T2 temp_s(Move(p.Second));
+		p.Second = Move(Second);
+		Second = Move(temp_s);
+	}
+
+	template<typename T1, typename T2>
+	inline void Swap(Pair<T1, T2>& left, Pair<T1, T2>& right)
+	{
+		left.Swap(right);
+	}
+
+	template<typename T>				bool Less(const T& left, const T& right)						{ return left < right; }
+	template<typename T1, typename T2>	bool Less(const Pair<T1, T2>& left, const Pair<T1, T2>& right)	{return left.First < right.First;}
+
+}
+
+#endif // !DVTL_UTILITY_H
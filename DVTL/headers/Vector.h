@@ -480,7 +480,8 @@ namespace DVTL
 		if (m_size == m_capacity) 
 			AllocateAndMove(CalculateNewCapacity(m_capacity));
 
-		Allocator::Construct(m_data, m_size++, value);
+		Allocator::Construct(m_data, m_size, value);
+		++m_size;
 	}
 
 	template<typename T>
@@ -489,7 +490,8 @@ namespace DVTL
 		if (m_size == m_capacity)
 			AllocateAndMove(CalculateNewCapacity(m_capacity));
 
-		Allocator::Construct(m_data, m_size++, Move(value));
+		Allocator::Construct(m_data, m_size, Move(value));
+		++m_size;
 	}
 
 	template<typename T>
@@ -518,7 +520,9 @@ namespace DVTL
 		if (m_size == m_capacity)
 			AllocateAndMove(CalculateNewCapacity(m_capacity));
 
-		new (m_data + m_size++) T(Forward<Types>(args)...);
+		//counted only once built, a throwing constructor leaves the size unchanged
+		new (m_data + m_size) T(Forward<Types>(args)...);
+		++m_size;
 
 		return Vector<T>::iterator(m_data+m_size-1);
 	}
@@ -583,7 +587,7 @@ namespace DVTL
 		Unique_ptr<T> safePtr(newData);
 
 		for (size_t i = 0; i < m_size; i++)
-			Allocator::Construct(newData, i, m_data[i]);
+			Allocator::Construct(newData, i, Move(m_data[i]));
 
 		for (size_t i = 0; i < m_size; i++)
 			Allocator::Destroy(m_data, i);
@@ -613,7 +617,7 @@ namespace DVTL
 		const_iterator endVec = CEnd();
 
 		while (endErase != endVec) {
-			Allocator::Construct(startErase.get(), *endErase);
+			Allocator::Construct(startErase.get(), Move(*endErase.get()));
 			Allocator::Destroy(endErase.get());
 			++endErase;
 			++startErase;
@@ -640,7 +644,7 @@ namespace DVTL
 		const_iterator pos(m_data + index - 1);
 
 		while (startInsert != pos) {
-			Allocator::Construct(endInsert.get(), *startInsert);
+			Allocator::Construct(endInsert.get(), Move(*startInsert.get()));
 			Allocator::Destroy(startInsert.get());
 			--endInsert;
 			--startInsert;
@@ -0,0 +1,466 @@
+#ifndef DVTL_VIEWS_H
+#define DVTL_VIEWS_H
+
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace DVTL
+{
+namespace Views
+{
+	//view and adaptor detection
+	template<typename T, typename = void> struct Is_view : False_type {};
+	template<typename T> struct Is_view<T, Void_t<typename T::is_view>> : True_type {};
+
+	template<typename T, typename = void> struct Is_adaptor : False_type {};
+	template<typename T> struct Is_adaptor<T, Void_t<typename T::is_adaptor>> : True_type {};
+
+	template<typename T, typename = void> struct Has_size : False_type {};
+	template<typename T> struct Has_size<T, Void_t<decltype(Declval<const T&>().Size())>> : True_type {};
+
+	template<typename T_Range> using Iterator_t = decltype(Declval<const T_Range&>().Begin());
+	template<typename T_Range> using Reference_t = decltype(*Declval<const Iterator_t<T_Range>&>());
+
+	//element type stored by a materialized view, pairs of references become pairs of values
+	template<typename T> struct Materialized { typedef T type; };
+	template<typename T1, typename T2> struct Materialized<Pair<T1, T2>> { typedef Pair<Remove_cvref_t<T1>, Remove_cvref_t<T2>> type; };
+
+	template<typename T_Range> using Value_t = typename Materialized<Remove_cvref_t<Reference_t<T_Range>>>::type;
+
+	template<typename T_Iterator>
+	inline T_Iterator Advance(T_Iterator it, const T_Iterator& last, size_t count)
+	{
+		while (count > 0 && it != last)
+		{
+			++it;
+			--count;
+		}
+
+		return it;
+	}
+
+	//non-owning view of a container
+	template<typename T_Range>
+	class Ref_view
+	{
+	public:
+		typedef void is_view;
+
+		explicit Ref_view(T_Range& range) :m_range(&range) {}
+
+		auto Begin()	const { return m_range->Begin(); }
+		auto End()		const { return m_range->End(); }
+		template<typename T_Base = T_Range> auto Size() const -> decltype(Declval<T_Base&>().Size()) { return m_range->Size(); }
+	private:
+		T_Range* m_range;
+	};
+
+	//pair of iterators, the element of Chunk
+	template<typename T_Iterator>
+	class Range
+	{
+	public:
+		typedef void is_view;
+
+		Range(const T_Iterator& first, const T_Iterator& last) :m_first(first), m_last(last) {}
+
+		T_Iterator Begin()	const { return m_first; }
+		T_Iterator End()	const { return m_last; }
+		template<typename T_It = T_Iterator> auto Size() const -> decltype(static_cast<size_t>(Declval<const T_It&>() - Declval<const T_It&>())) { return static_cast<size_t>(m_last - m_first); }
+	private:
+		T_Iterator m_first;
+		T_Iterator m_last;
+	};
+
+	namespace Detail
+	{
+		template<typename T_Range>
+		inline Remove_cvref_t<T_Range> all(T_Range&& range, True_type) { return Forward<T_Range>(range); }
+
+		template<typename T_Range>
+		inline Ref_view<T_Range> all(T_Range& range, False_type) { return Ref_view<T_Range>(range); }
+
+		template<typename T_Container, typename T_Range>
+		inline void reserve(T_Container& container, const T_Range& range, True_type) { container.Reserve(range.Size()); }
+
+		template<typename T_Container, typename T_Range>
+		inline void reserve(T_Container&, const T_Range&, False_type) {}
+	}
+
+	//views pass through, containers are referenced
+	template<typename T_Range>
+	inline auto All(T_Range&& range)
+	{
+		return Detail::all(Forward<T_Range>(range), Is_view<Remove_cvref_t<T_Range>>());
+	}
+
+	template<typename T_Range, typename T_Adaptor, typename = Enable_if_t<Is_adaptor<T_Adaptor>::value>>
+	inline auto operator|(T_Range&& range, const T_Adaptor& adaptor)
+	{
+		return adaptor(All(Forward<T_Range>(range)));
+	}
+
+	//Filter
+	template<typename T_Base, typename T_Predicate>
+	class Filter_view
+	{
+	public:
+		typedef void is_view;
+
+		class iterator
+		{
+		public:
+			iterator(const Iterator_t<T_Base>& it, const Iterator_t<T_Base>& last, const T_Predicate* predicate) :m_it(it), m_last(last), m_predicate(predicate) { skip(); }
+
+			bool operator==(const iterator& other) const { return m_it == other.m_it; }
+			bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+
+			decltype(auto) operator*() const { return *m_it; }
+
+			iterator& operator++()			{ ++m_it; skip(); return *this; }
+			const iterator operator++(int)	{ iterator temp = *this; ++*this; return temp; }
+		private:
+			void skip() { while (m_it != m_last && !(*m_predicate)(*m_it)) ++m_it; }
+
+			Iterator_t<T_Base> m_it;
+			Iterator_t<T_Base> m_last;
+			const T_Predicate* m_predicate;
+		};
+
+		Filter_view(const T_Base& base, const T_Predicate& predicate) :m_base(base), m_predicate(predicate) {}
+
+		iterator Begin()	const { return iterator(m_base.Begin(), m_base.End(), &m_predicate); }
+		iterator End()		const { return iterator(m_base.End(), m_base.End(), &m_predicate); }
+	private:
+		T_Base m_base;
+		T_Predicate m_predicate;
+	};
+
+	template<typename T_Predicate>
+	struct Filter_adaptor
+	{
+		typedef void is_adaptor;
+		T_Predicate predicate;
+
+		template<typename T_Base> Filter_view<T_Base, T_Predicate> operator()(const T_Base& base) const { return Filter_view<T_Base, T_Predicate>(base, predicate); }
+	};
+
+	template<typename T_Predicate>
+	inline Filter_adaptor<T_Predicate> Filter(T_Predicate predicate) { return Filter_adaptor<T_Predicate>{ predicate }; }
+
+	//Transform
+	template<typename T_Base, typename T_Function>
+	class Transform_view
+	{
+	public:
+		typedef void is_view;
+
+		class iterator
+		{
+		public:
+			iterator(const Iterator_t<T_Base>& it, const T_Function* function) :m_it(it), m_function(function) {}
+
+			bool operator==(const iterator& other) const { return m_it == other.m_it; }
+			bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+
+			decltype(auto) operator*() const { return (*m_function)(*m_it); }
+
+			iterator& operator++()			{ ++m_it; return *this; }
+			const iterator operator++(int)	{ iterator temp = *this; ++m_it; return temp; }
+		private:
+			Iterator_t<T_Base> m_it;
+			const T_Function* m_function;
+		};
+
+		Transform_view(const T_Base& base, const T_Function& function) :m_base(base), m_function(function) {}
+
+		iterator Begin()	const { return iterator(m_base.Begin(), &m_function); }
+		iterator End()		const { return iterator(m_base.End(), &m_function); }
+		template<typename T = T_Base> auto Size() const -> decltype(Declval<const T&>().Size()) { return m_base.Size(); }
+	private:
+		T_Base m_base;
+		T_Function m_function;
+	};
+
+	template<typename T_Function>
+	struct Transform_adaptor
+	{
+		typedef void is_adaptor;
+		T_Function function;
+
+		template<typename T_Base> Transform_view<T_Base, T_Function> operator()(const T_Base& base) const { return Transform_view<T_Base, T_Function>(base, function); }
+	};
+
+	template<typename T_Function>
+	inline Transform_adaptor<T_Function> Transform(T_Function function) { return Transform_adaptor<T_Function>{ function }; }
+
+	//Take
+	template<typename T_Base>
+	class Take_view
+	{
+	public:
+		typedef void is_view;
+
+		class iterator
+		{
+		public:
+			iterator(const Iterator_t<T_Base>& it, size_t remaining) :m_it(it), m_remaining(remaining) {}
+
+			bool operator==(const iterator& other) const { return m_remaining == other.m_remaining || m_it == other.m_it; }
+			bool operator!=(const iterator& other) const { return !(*this == other); }
+
+			decltype(auto) operator*() const { return *m_it; }
+
+			iterator& operator++()			{ ++m_it; --m_remaining; return *this; }
+			const iterator operator++(int)	{ iterator temp = *this; ++*this; return temp; }
+		private:
+			Iterator_t<T_Base> m_it;
+			size_t m_remaining;
+		};
+
+		Take_view(const T_Base& base, size_t count) :m_base(base), m_count(count) {}
+
+		iterator Begin()	const { return iterator(m_base.Begin(), m_count); }
+		iterator End()		const { return iterator(m_base.End(), 0); }
+		template<typename T = T_Base> auto Size() const -> decltype(Declval<const T&>().Size()) { return Min<size_t>(m_base.Size(), m_count); }
+	private:
+		T_Base m_base;
+		size_t m_count;
+	};
+
+	//Drop
+	template<typename T_Base>
+	class Drop_view
+	{
+	public:
+		typedef void is_view;
+
+		Drop_view(const T_Base& base, size_t count) :m_base(base), m_count(count) {}
+
+		Iterator_t<T_Base> Begin()	const { return Advance(m_base.Begin(), m_base.End(), m_count); }
+		Iterator_t<T_Base> End()	const { return m_base.End(); }
+		template<typename T = T_Base> auto Size() const -> decltype(Declval<const T&>().Size()) { return m_base.Size() - Min<size_t>(m_base.Size(), m_count); }
+	private:
+		T_Base m_base;
+		size_t m_count;
+	};
+
+	//Stride
+	template<typename T_Base>
+	class Stride_view
+	{
+	public:
+		typedef void is_view;
+
+		class iterator
+		{
+		public:
+			iterator(const Iterator_t<T_Base>& it, const Iterator_t<T_Base>& last, size_t step) :m_it(it), m_last(last), m_step(step) {}
+
+			bool operator==(const iterator& other) const { return m_it == other.m_it; }
+			bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+
+			decltype(auto) operator*() const { return *m_it; }
+
+			iterator& operator++()			{ m_it = Advance(m_it, m_last, m_step); return *this; }
+			const iterator operator++(int)	{ iterator temp = *this; ++*this; return temp; }
+		private:
+			Iterator_t<T_Base> m_it;
+			Iterator_t<T_Base> m_last;
+			size_t m_step;
+		};
+
+		Stride_view(const T_Base& base, size_t step) :m_base(base), m_step(step == 0 ? 1 : step) {}
+
+		iterator Begin()	const { return iterator(m_base.Begin(), m_base.End(), m_step); }
+		iterator End()		const { return iterator(m_base.End(), m_base.End(), m_step); }
+		template<typename T = T_Base> auto Size() const -> decltype(Declval<const T&>().Size()) { return (m_base.Size() + m_step - 1) / m_step; }
+	private:
+		T_Base m_base;
+		size_t m_step;
+	};
+
+	//Chunk
+	template<typename T_Base>
+	class Chunk_view
+	{
+	public:
+		typedef void is_view;
+
+		class iterator
+		{
+		public:
+			iterator(const Iterator_t<T_Base>& it, const Iterator_t<T_Base>& last, size_t count) :m_it(it), m_next(Advance(it, last, count)), m_last(last), m_count(count) {}
+
+			bool operator==(const iterator& other) const { return m_it == other.m_it; }
+			bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+
+			Range<Iterator_t<T_Base>> operator*() const { return Range<Iterator_t<T_Base>>(m_it, m_next); }
+
+			iterator& operator++()
+			{
+				m_it = m_next;
+				m_next = Advance(m_next, m_last, m_count);
+				return *this;
+			}
+
+			const iterator operator++(int) { iterator temp = *this; ++*this; return temp; }
+		private:
+			Iterator_t<T_Base> m_it;
+			Iterator_t<T_Base> m_next;
+			Iterator_t<T_Base> m_last;
+			size_t m_count;
+		};
+
+		Chunk_view(const T_Base& base, size_t count) :m_base(base), m_count(count == 0 ? 1 : count) {}
+
+		iterator Begin()	const { return iterator(m_base.Begin(), m_base.End(), m_count); }
+		iterator End()		const { return iterator(m_base.End(), m_base.End(), m_count); }
+		template<typename T = T_Base> auto Size() const -> decltype(Declval<const T&>().Size()) { return (m_base.Size() + m_count - 1) / m_count; }
+	private:
+		T_Base m_base;
+		size_t m_count;
+	};
+
+	template<template<typename> class T_View>
+	struct Count_adaptor
+	{
+		typedef void is_adaptor;
+		size_t count;
+
+		template<typename T_Base> T_View<T_Base> operator()(const T_Base& base) const { return T_View<T_Base>(base, count); }
+	};
+
+	inline Count_adaptor<Take_view>		Take(size_t count)		{ return Count_adaptor<Take_view>{ count }; }
+	inline Count_adaptor<Drop_view>		Drop(size_t count)		{ return Count_adaptor<Drop_view>{ count }; }
+	inline Count_adaptor<Stride_view>	Stride(size_t step)		{ return Count_adaptor<Stride_view>{ step }; }
+	inline Count_adaptor<Chunk_view>	Chunk(size_t count)		{ return Count_adaptor<Chunk_view>{ count }; }
+
+	//Enumerate
+	template<typename T_Base>
+	class Enumerate_view
+	{
+	public:
+		typedef void is_view;
+
+		class iterator
+		{
+		public:
+			iterator(const Iterator_t<T_Base>& it, size_t index) :m_it(it), m_index(index) {}
+
+			bool operator==(const iterator& other) const { return m_it == other.m_it; }
+			bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+
+			Pair<size_t, Reference_t<T_Base>> operator*() const { return Pair<size_t, Reference_t<T_Base>>(m_index, *m_it); }
+
+			iterator& operator++()			{ ++m_it; ++m_index; return *this; }
+			const iterator operator++(int)	{ iterator temp = *this; ++*this; return temp; }
+		private:
+			Iterator_t<T_Base> m_it;
+			size_t m_index;
+		};
+
+		explicit Enumerate_view(const T_Base& base) :m_base(base) {}
+
+		iterator Begin()	const { return iterator(m_base.Begin(), 0); }
+		iterator End()		const { return iterator(m_base.End(), 0); }
+		template<typename T = T_Base> auto Size() const -> decltype(Declval<const T&>().Size()) { return m_base.Size(); }
+	private:
+		T_Base m_base;
+	};
+
+	struct Enumerate_adaptor
+	{
+		typedef void is_adaptor;
+
+		template<typename T_Base> Enumerate_view<T_Base> operator()(const T_Base& base) const { return Enumerate_view<T_Base>(base); }
+	};
+
+	inline Enumerate_adaptor Enumerate() { return Enumerate_adaptor(); }
+
+	//Zip
+	template<typename T_Base1, typename T_Base2>
+	class Zip_view
+	{
+	public:
+		typedef void is_view;
+
+		class iterator
+		{
+		public:
+			iterator(const Iterator_t<T_Base1>& it1, const Iterator_t<T_Base2>& it2) :m_it1(it1), m_it2(it2) {}
+
+			//the shorter range ends the zip
+			bool operator==(const iterator& other) const { return m_it1 == other.m_it1 || m_it2 == other.m_it2; }
+			bool operator!=(const iterator& other) const { return !(*this == other); }
+
+			Pair<Reference_t<T_Base1>, Reference_t<T_Base2>> operator*() const { return Pair<Reference_t<T_Base1>, Reference_t<T_Base2>>(*m_it1, *m_it2); }
+
+			iterator& operator++()			{ ++m_it1; ++m_it2; return *this; }
+			const iterator operator++(int)	{ iterator temp = *this; ++*this; return temp; }
+		private:
+			Iterator_t<T_Base1> m_it1;
+			Iterator_t<T_Base2> m_it2;
+		};
+
+		Zip_view(const T_Base1& base1, const T_Base2& base2) :m_base1(base1), m_base2(base2) {}
+
+		iterator Begin()	const { return iterator(m_base1.Begin(), m_base2.Begin()); }
+		iterator End()		const { return iterator(m_base1.End(), m_base2.End()); }
+		template<typename T1 = T_Base1, typename T2 = T_Base2> auto Size() const -> decltype(Declval<const T1&>().Size() + Declval<const T2&>().Size())
+		{
+			return Min<size_t>(m_base1.Size(), m_base2.Size());
+		}
+	private:
+		T_Base1 m_base1;
+		T_Base2 m_base2;
+	};
+
+	template<typename T_Other>
+	struct Zip_adaptor
+	{
+		typedef void is_adaptor;
+		T_Other other;
+
+		template<typename T_Base> Zip_view<T_Base, T_Other> operator()(const T_Base& base) const { return Zip_view<T_Base, T_Other>(base, other); }
+	};
+
+	template<typename T_Range>
+	inline auto Zip(T_Range&& range)
+	{
+		typedef decltype(All(Forward<T_Range>(range))) T_Other;
+		return Zip_adaptor<T_Other>{ All(Forward<T_Range>(range)) };
+	}
+
+	template<typename T_Range1, typename T_Range2>
+	inline auto Zip(T_Range1&& range1, T_Range2&& range2)
+	{
+		return All(Forward<T_Range1>(range1)) | Zip(Forward<T_Range2>(range2));
+	}
+
+	//materializing a view into a container
+	template<template<typename...> class T_Container>
+	struct To_adaptor
+	{
+		typedef void is_adaptor;
+
+		template<typename T_Base>
+		T_Container<Value_t<T_Base>> operator()(const T_Base& base) const
+		{
+			T_Container<Value_t<T_Base>> result;
+			Detail::reserve(result, base, Has_size<T_Base>());
+
+			auto last = base.End();
+			for (auto it = base.Begin(); it != last; ++it)
+				result.Emplace_back(*it);
+
+			return result;
+		}
+	};
+
+	template<template<typename...> class T_Container>
+	inline To_adaptor<T_Container> To() { return To_adaptor<T_Container>(); }
+}
+}
+
+#endif // !DVTL_VIEWS_H
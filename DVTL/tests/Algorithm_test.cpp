@@ -0,0 +1,124 @@
+//Remove and Unique compared with the std algorithms on the element types with vector kernels,
+//every kernel the processor supports is run directly as well, so a machine with AVX-512 still checks the AVX2 one
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Algorithm.h"
+#include "Vector.h"
+#include "Check.h"
+
+namespace
+{
+	//bitwise, so -0.0 kept in place of 0.0 is caught
+	template<typename T>
+	bool Same_prefix(const T* data, const std::vector<T>& reference, size_t count)
+	{
+		return count == 0 || std::memcmp(data, reference.data(), count * sizeof(T)) == 0;
+	}
+
+	template<typename T>
+	void Check_kernels(const std::vector<T>& input, T value, const std::vector<T>& removed, const std::vector<T>& unique)
+	{
+#if DVTL_ALGORITHM_SIMD
+		constexpr bool floating = DVTL::Is_same_v<T, float> || DVTL::Is_same_v<T, double>;
+		typedef DVTL::Detail::Avx2_lanes<sizeof(T), floating> Avx2_lanes;
+		typedef DVTL::Detail::Avx512_lanes<sizeof(T), floating> Avx512_lanes;
+		DVTL::Detail::Simd_level level = DVTL::Detail::simdLevel();
+
+		if (level >= DVTL::Detail::Simd_avx2) {
+			std::vector<T> data = input;
+			DVTL_CHECK(DVTL::Detail::removeAvx2<Avx2_lanes>(data.data(), data.size(), value) == removed.size());
+			DVTL_CHECK(Same_prefix(data.data(), removed, removed.size()));
+
+			if (!input.empty()) {
+				data = input;
+				DVTL_CHECK(DVTL::Detail::uniqueAvx2<Avx2_lanes>(data.data(), data.size()) == unique.size());
+				DVTL_CHECK(Same_prefix(data.data(), unique, unique.size()));
+			}
+		}
+
+		if (level >= DVTL::Detail::Simd_avx512) {
+			std::vector<T> data = input;
+			DVTL_CHECK(DVTL::Detail::removeAvx512<Avx512_lanes>(data.data(), data.size(), value) == removed.size());
+			DVTL_CHECK(Same_prefix(data.data(), removed, removed.size()));
+
+			if (!input.empty()) {
+				data = input;
+				DVTL_CHECK(DVTL::Detail::uniqueAvx512<Avx512_lanes>(data.data(), data.size()) == unique.size());
+				DVTL_CHECK(Same_prefix(data.data(), unique, unique.size()));
+			}
+		}
+#else
+		(void)input; (void)value; (void)removed; (void)unique;
+#endif
+	}
+
+	//sizes around every block width, then long runs; few distinct values so both kept and dropped lanes are common
+	template<typename T, typename T_Generator>
+	void Check_compaction(int seed, T_Generator generate)
+	{
+		static_assert(DVTL::Detail::Is_simd_element_v<T>, "the element type has vector kernels");
+
+		std::mt19937 random(seed);
+		for (int round = 0; round < 600; ++round)
+		{
+			size_t size = round < 100 ? static_cast<size_t>(round) : random() % 3000;
+			unsigned int distinct = 1 + random() % 5;
+
+			std::vector<T> input(size);
+			for (T& element : input)
+				element = generate(random() % (distinct + 2), distinct);
+			T value = size != 0 ? input[random() % size] : generate(0, distinct);
+
+			std::vector<T> removed = input;
+			removed.erase(std::remove(removed.begin(), removed.end(), value), removed.end());
+			std::vector<T> unique = input;
+			unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+			std::vector<T> data = input;
+			T* end = DVTL::Remove(data.data(), data.data() + size, value);
+			DVTL_CHECK(static_cast<size_t>(end - data.data()) == removed.size() && Same_prefix(data.data(), removed, removed.size()));
+
+			data = input;
+			end = DVTL::Unique(data.data(), data.data() + size);
+			DVTL_CHECK(static_cast<size_t>(end - data.data()) == unique.size() && Same_prefix(data.data(), unique, unique.size()));
+
+			DVTL::Vector<T> vector;
+			for (const T& element : input)
+				vector.Push_back(element);
+			auto vectorEnd = DVTL::Remove(vector.Begin(), vector.End(), value);
+			DVTL_CHECK(static_cast<size_t>(vectorEnd - vector.Begin()) == removed.size() && Same_prefix(vector.Data(), removed, removed.size()));
+
+			Check_kernels(input, value, removed, unique);
+		}
+	}
+
+	//key distinct and distinct + 1 become NaN and -0.0, neither compares like its bits
+	template<typename T>
+	T Make_floating(unsigned int key, unsigned int distinct)
+	{
+		if (key == distinct) return static_cast<T>(NAN);
+		if (key == distinct + 1) return static_cast<T>(-0.0);
+		return static_cast<T>(key);
+	}
+}
+
+int main()
+{
+	Check_compaction<int>(1, [](unsigned int key, unsigned int) { return static_cast<int>(key) - 3; });
+	Check_compaction<unsigned int>(2, [](unsigned int key, unsigned int) { return key * 0x9E3779B9u; });
+	Check_compaction<long long>(3, [](unsigned int key, unsigned int) { return static_cast<long long>(key) << 33 | 1; });
+	Check_compaction<unsigned long long>(4, [](unsigned int key, unsigned int) { return key * 0x9E3779B97F4A7C15ull; });
+	Check_compaction<float>(5, Make_floating<float>);
+	Check_compaction<double>(6, Make_floating<double>);
+
+	//a value of another type compares after conversion, so it stays on the element by element path
+	int mixed[] = { 1, 2, 1, 3 };
+	DVTL_CHECK(DVTL::Remove(mixed, mixed + 4, 1.5) == mixed + 4);
+
+	return Check::Finish("dvtl_test_algorithm");
+}
@@ -0,0 +1,40 @@
+#ifndef DVTL_CHECK_H
+#define DVTL_CHECK_H
+
+#include <cstdio>
+
+//shared harness of the test executables: a failed check prints its expression and location,
+//Finish returns the exit code that makes ctest report the executable as failed
+namespace Check
+{
+	inline int& Failures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	//a broken container tends to fail the same check thousands of times, only the first ones are printed
+	inline bool Report(bool passed, const char* expression, const char* file, int line)
+	{
+		if (passed) return true;
+
+		if (++Failures() <= 20)
+			std::printf("%s:%d: check failed: %s\n", file, line, expression);
+		return false;
+	}
+
+	inline int Finish(const char* name)
+	{
+		if (Failures() == 0) {
+			std::printf("%s: all checks passed\n", name);
+			return 0;
+		}
+
+		std::printf("%s: %d checks failed\n", name, Failures());
+		return 1;
+	}
+}
+
+#define DVTL_CHECK(expression) Check::Report(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#endif // !DVTL_CHECK_H
@@ -0,0 +1,510 @@
+//differential checks of the ordered and hashed containers: random operation sequences run on a DVTL container
+//and on its std counterpart, and the contents are compared after every phase;
+//values count their live instances so leaked or doubly destroyed elements are caught as well
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BTree_map.h"
+#include "Compact_map.h"
+#include "Flat_map.h"
+#include "Flat_set.h"
+#include "Hash_map.h"
+#include "Map.h"
+#include "Check.h"
+
+namespace
+{
+	long long liveValues = 0;
+
+	//value that counts its live instances
+	struct Counted
+	{
+		int value;
+
+		Counted() :value(0) { ++liveValues; }
+		Counted(int value) :value(value) { ++liveValues; }
+		Counted(const Counted& right) :value(right.value) { ++liveValues; }
+		Counted(Counted&& right) noexcept :value(right.value) { ++liveValues; }
+		Counted& operator=(const Counted& right) { value = right.value; return *this; }
+		Counted& operator=(Counted&& right) noexcept { value = right.value; return *this; }
+		~Counted() { --liveValues; }
+	};
+
+	std::string Make_key(int key, std::string*)
+	{
+		//longer than the small string buffer so every key owns an allocation
+		return "key-" + std::to_string(1000000000 + key) + "-padding";
+	}
+
+	int Make_key(int key, int*)
+	{
+		return key;
+	}
+
+	template<typename T_Key>
+	T_Key Key(int key)
+	{
+		return Make_key(key, static_cast<T_Key*>(nullptr));
+	}
+
+	//same elements in the same order
+	template<typename T_Map, typename T_Key>
+	bool Same_ordered(const T_Map& map, const std::map<T_Key, int>& reference)
+	{
+		if (map.Size() != reference.size() || map.Empty() != reference.empty()) return false;
+
+		auto it = map.Begin();
+		for (const auto& entry : reference) {
+			if (it == map.End() || !(it->First == entry.first) || it->Second.value != entry.second) return false;
+			++it;
+		}
+		return it == map.End();
+	}
+
+	template<typename T_Map, typename T_Key>
+	bool Same_reversed(const T_Map& map, const std::map<T_Key, int>& reference)
+	{
+		auto it = map.RBegin();
+		for (auto entry = reference.rbegin(); entry != reference.rend(); ++entry) {
+			if (it == map.REnd() || !(it->First == entry->first)) return false;
+			++it;
+		}
+		return it == map.REnd();
+	}
+
+	//inserts, assignments, erases and lookups shared by every map
+	template<typename T_Map, typename T_Key>
+	void Random_operations(T_Map& map, std::map<T_Key, int>& reference, std::mt19937& random, int operations, int keyRange)
+	{
+		for (int i = 0; i < operations; ++i)
+		{
+			int raw = static_cast<int>(random() % keyRange);
+			T_Key key = Key<T_Key>(raw);
+
+			switch (random() % 7)
+			{
+			case 0:
+			case 1: {
+				auto result = map.Insert(key, Counted(i));
+				bool inserted = reference.emplace(key, i).second;
+				DVTL_CHECK(result.Second == inserted);
+				DVTL_CHECK(result.First->First == key && result.First->Second.value == reference[key]);
+				break;
+			}
+			case 2: {
+				auto result = map.Insert_or_assign(key, Counted(i));
+				DVTL_CHECK(result.Second == (reference.count(key) == 0));
+				reference[key] = i;
+				break;
+			}
+			case 3: {
+				auto result = map.Try_emplace(key, i);
+				DVTL_CHECK(result.Second == reference.emplace(key, i).second);
+				break;
+			}
+			case 4:
+			case 5:
+				map.Erase(key);
+				reference.erase(key);
+				break;
+			default: {
+				auto found = map.Find(key);
+				auto expected = reference.find(key);
+				DVTL_CHECK((found == map.End()) == (expected == reference.end()));
+				if (expected != reference.end() && found != map.End())
+					DVTL_CHECK(found->Second.value == expected->second);
+				DVTL_CHECK(map.Contains(key) == (expected != reference.end()));
+				break;
+			}
+			}
+		}
+	}
+
+	template<typename T_Map, typename T_Key>
+	void Check_copies(const T_Map& map, const std::map<T_Key, int>& reference)
+	{
+		T_Map copy(map);
+		DVTL_CHECK(Same_ordered(copy, reference));
+
+		T_Map assigned;
+		assigned = copy;
+		T_Map moved(DVTL::Move(copy));
+		DVTL_CHECK(Same_ordered(moved, reference));
+		DVTL_CHECK(Same_ordered(assigned, reference));
+		DVTL_CHECK(copy.Empty());
+	}
+
+	template<typename T_Map, typename T_Key>
+	void Check_ordered_map(const char*, int seed, int keyRange)
+	{
+		std::mt19937 random(seed);
+		{
+			T_Map map;
+			std::map<T_Key, int> reference;
+			DVTL_CHECK(map.Begin() == map.End());
+
+			for (int phase = 0; phase < 6; ++phase) {
+				Random_operations(map, reference, random, 3000, keyRange);
+				DVTL_CHECK(Same_ordered(map, reference));
+			}
+
+			Check_copies(map, reference);
+
+			map.Clear();
+			DVTL_CHECK(map.Empty() && map.Begin() == map.End());
+			Random_operations(map, reference = std::map<T_Key, int>(), random, 2000, keyRange);
+			DVTL_CHECK(Same_ordered(map, reference));
+		}
+		DVTL_CHECK(liveValues == 0);
+	}
+
+	template<typename T_Key>
+	void Check_map_queries(int seed)
+	{
+		typedef DVTL::Map<T_Key, Counted> Map;
+		std::mt19937 random(seed);
+		{
+			Map map;
+			std::map<T_Key, int> reference;
+			Random_operations(map, reference, random, 4000, 3000);
+			DVTL_CHECK(Same_ordered(map, reference));
+			DVTL_CHECK(Same_reversed(map, reference));
+
+			//bounds
+			for (int i = 0; i < 500; ++i) {
+				T_Key key = Key<T_Key>(static_cast<int>(random() % 3100));
+				auto lower = map.Lower_bound(key);
+				auto upper = map.Upper_bound(key);
+				auto expectedLower = reference.lower_bound(key);
+				auto expectedUpper = reference.upper_bound(key);
+				DVTL_CHECK((lower == map.End()) == (expectedLower == reference.end()));
+				DVTL_CHECK((upper == map.End()) == (expectedUpper == reference.end()));
+				if (lower != map.End() && expectedLower != reference.end()) DVTL_CHECK(lower->First == expectedLower->first);
+				if (upper != map.End() && expectedUpper != reference.end()) DVTL_CHECK(upper->First == expectedUpper->first);
+
+				auto range = map.Equal_range(key);
+				DVTL_CHECK(range.First == lower && range.Second == upper);
+			}
+
+			//order statistics and iterator arithmetic
+			std::vector<T_Key> keys;
+			for (const auto& entry : reference)
+				keys.push_back(entry.first);
+
+			for (size_t i = 0; i < keys.size(); i += 7) {
+				auto selected = map.Select(i);
+				DVTL_CHECK(selected != map.End() && selected->First == keys[i]);
+				DVTL_CHECK(map.Rank(keys[i]) == i);
+
+				size_t step = random() % 40;
+				auto moved = selected + static_cast<ptrdiff_t>(step);
+				if (i + step < keys.size()) DVTL_CHECK(moved != map.End() && moved->First == keys[i + step]);
+				else DVTL_CHECK(moved == map.End());
+
+				if (i >= step) DVTL_CHECK((selected - static_cast<ptrdiff_t>(step))->First == keys[i - step]);
+			}
+			DVTL_CHECK(map.Select(keys.size()) == map.End());
+
+			for (int i = 0; i < 300; ++i) {
+				T_Key low = Key<T_Key>(static_cast<int>(random() % 3100));
+				T_Key high = Key<T_Key>(static_cast<int>(random() % 3100));
+				size_t expected = high < low ? 0 : static_cast<size_t>(std::distance(reference.lower_bound(low), reference.lower_bound(high)));
+				DVTL_CHECK(map.Count_range(low, high) == expected);
+			}
+
+			//erasing single positions and ranges
+			for (int i = 0; i < 200 && !reference.empty(); ++i) {
+				size_t first = random() % reference.size();
+				size_t count = i % 3 == 0 ? 1 : random() % (reference.size() - first + 1);
+				auto expectedFirst = std::next(reference.begin(), static_cast<ptrdiff_t>(first));
+				auto expectedLast = std::next(expectedFirst, static_cast<ptrdiff_t>(count));
+				auto after = expectedLast == reference.end() ? nullptr : &expectedLast->first;
+
+				typename Map::iterator result = count == 1 && i % 2 == 0
+					? map.Erase(map.Select(first))
+					: map.Erase(map.Select(first), map.Select(first + count));
+				reference.erase(expectedFirst, expectedLast);
+
+				DVTL_CHECK(after == nullptr ? result == map.End() : (result != map.End() && result->First == *after));
+				if (i % 20 == 0) DVTL_CHECK(Same_ordered(map, reference));
+				if (reference.size() < 100) Random_operations(map, reference, random, 500, 3000);
+			}
+			DVTL_CHECK(Same_ordered(map, reference));
+
+			map.Erase(map.Begin(), map.End());
+			DVTL_CHECK(map.Empty() && map.Size() == 0);
+		}
+		DVTL_CHECK(liveValues == 0);
+	}
+
+	//From_sorted, the range Insert and the list constructor keep the first of repeated keys like repeated Insert calls
+	template<typename T_Key>
+	void Check_map_bulk(int seed)
+	{
+		typedef DVTL::Map<T_Key, Counted> Map;
+		std::mt19937 random(seed);
+		{
+			for (int round = 0; round < 30; ++round) {
+				size_t size = random() % 2000;
+				int range = 1 + static_cast<int>(random() % 4000);
+				std::vector<DVTL::Pair<T_Key, Counted>> entries;
+				for (size_t i = 0; i < size; ++i)
+					entries.push_back(DVTL::Pair<T_Key, Counted>(Key<T_Key>(static_cast<int>(random() % range)), Counted(static_cast<int>(i))));
+
+				//sorted input, with repeated keys in every other round
+				std::vector<DVTL::Pair<T_Key, Counted>> sorted = entries;
+				std::stable_sort(sorted.begin(), sorted.end(), [](const auto& left, const auto& right) { return left.First < right.First; });
+				if (round % 2 == 0)
+					sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const auto& left, const auto& right) { return left.First == right.First; }), sorted.end());
+
+				std::map<T_Key, int> reference;
+				for (const auto& entry : sorted)
+					reference.emplace(entry.First, entry.Second.value);
+
+				Map built = Map::From_sorted(sorted.begin(), sorted.end());
+				DVTL_CHECK(Same_ordered(built, reference));
+				DVTL_CHECK(Same_reversed(built, reference));
+				for (size_t i = 0; i < reference.size(); i += 13)
+					DVTL_CHECK(built.Select(i)->First == std::next(reference.begin(), static_cast<ptrdiff_t>(i))->first);
+
+				//unsorted input falls back to inserting
+				std::map<T_Key, int> unsortedReference;
+				for (const auto& entry : entries)
+					unsortedReference.emplace(entry.First, entry.Second.value);
+				Map unsorted = Map::From_sorted(entries.begin(), entries.end());
+				DVTL_CHECK(Same_ordered(unsorted, unsortedReference));
+
+				//merging a batch into a filled map, existing entries win
+				Map merged;
+				std::map<T_Key, int> mergedReference;
+				Random_operations(merged, mergedReference, random, 1500, range);
+				merged.Insert(entries.begin(), entries.end());
+				for (const auto& entry : entries)
+					mergedReference.emplace(entry.First, entry.Second.value);
+				DVTL_CHECK(Same_ordered(merged, mergedReference));
+				DVTL_CHECK(merged.Size() == 0 || merged.Select(merged.Size() - 1)->First == mergedReference.rbegin()->first);
+
+				Random_operations(merged, mergedReference, random, 500, range);
+				DVTL_CHECK(Same_ordered(merged, mergedReference));
+			}
+
+			DVTL::Pair<T_Key, Counted> list[] = {
+				DVTL::Pair<T_Key, Counted>(Key<T_Key>(3), Counted(1)),
+				DVTL::Pair<T_Key, Counted>(Key<T_Key>(1), Counted(2)),
+				DVTL::Pair<T_Key, Counted>(Key<T_Key>(3), Counted(3)),
+			};
+			Map listed(list);
+			DVTL_CHECK(listed.Size() == 2 && listed.At(Key<T_Key>(3)).value == 1);
+		}
+		DVTL_CHECK(liveValues == 0);
+	}
+
+	template<bool Order_statistics>
+	void Check_compact_map(int seed)
+	{
+		typedef DVTL::Compact_map<int, Counted, Order_statistics> Map;
+		std::mt19937 random(seed);
+		{
+			Map map;
+			std::map<int, int> reference;
+			for (int phase = 0; phase < 5; ++phase) {
+				Random_operations(map, reference, random, 4000, 2500);
+				DVTL_CHECK(Same_ordered(map, reference));
+				DVTL_CHECK(Same_reversed(map, reference));
+			}
+
+			Check_copies(map, reference);
+
+			map.Reserve(map.Capacity() * 2 + 100);
+			DVTL_CHECK(Same_ordered(map, reference));
+
+			DVTL::Pair<int, Counted> list[] = { DVTL::Pair<int, Counted>(5, Counted(1)), DVTL::Pair<int, Counted>(5, Counted(2)) };
+			Map listed(list);
+			DVTL_CHECK(listed.Size() == 1 && listed.At(5).value == 1);
+		}
+		DVTL_CHECK(liveValues == 0);
+	}
+
+	void Check_compact_map_statistics(int seed)
+	{
+		std::mt19937 random(seed);
+		{
+			DVTL::Compact_map<int, Counted, true> map;
+			std::map<int, int> reference;
+			Random_operations(map, reference, random, 6000, 4000);
+
+			size_t rank = 0;
+			for (const auto& entry : reference) {
+				if (rank % 5 == 0) {
+					DVTL_CHECK(map.Select(rank)->First == entry.first);
+					DVTL_CHECK(map.Rank(entry.first) == rank);
+					DVTL_CHECK(map.Rank(entry.first + 1) == rank + 1);
+				}
+				++rank;
+			}
+			DVTL_CHECK(map.Select(reference.size()) == map.End());
+		}
+		DVTL_CHECK(liveValues == 0);
+	}
+
+	template<typename T_Key>
+	void Check_flat_containers(int seed)
+	{
+		typedef DVTL::Flat_map<T_Key, Counted> Map;
+		std::mt19937 random(seed);
+		{
+			Map map;
+			std::map<T_Key, int> reference;
+			for (int phase = 0; phase < 4; ++phase) {
+				Random_operations(map, reference, random, 1500, 1200);
+				DVTL_CHECK(Same_ordered(map, reference));
+			}
+			Check_copies(map, reference);
+
+			//bulk construction and merging keep the first of repeated keys
+			std::vector<DVTL::Pair<T_Key, Counted>> entries;
+			for (int i = 0; i < 3000; ++i)
+				entries.push_back(DVTL::Pair<T_Key, Counted>(Key<T_Key>(static_cast<int>(random() % 900)), Counted(i)));
+
+			std::map<T_Key, int> firstWins;
+			for (const auto& entry : entries)
+				firstWins.emplace(entry.First, entry.Second.value);
+			DVTL_CHECK(Same_ordered(Map(entries.begin(), entries.end()), firstWins));
+
+			map.Insert(entries.begin(), entries.end());
+			for (const auto& entry : entries)
+				reference.emplace(entry.First, entry.Second.value);
+			DVTL_CHECK(Same_ordered(map, reference));
+
+			for (int i = 0; i < 300; ++i) {
+				T_Key key = Key<T_Key>(static_cast<int>(random() % 1000));
+				auto lower = reference.lower_bound(key);
+				DVTL_CHECK(map.Lower_bound(key) - map.Begin() == std::distance(reference.begin(), lower));
+				DVTL_CHECK(map.Upper_bound(key) - map.Begin() == std::distance(reference.begin(), reference.upper_bound(key)));
+			}
+		}
+		DVTL_CHECK(liveValues == 0);
+
+		DVTL::Flat_set<T_Key> set;
+		std::set<T_Key> setReference;
+		for (int i = 0; i < 5000; ++i) {
+			T_Key key = Key<T_Key>(static_cast<int>(random() % 1500));
+			if (random() % 3 == 0) {
+				set.Erase(key);
+				setReference.erase(key);
+			}
+			else
+				DVTL_CHECK(set.Insert(key).Second == setReference.insert(key).second);
+		}
+
+		std::vector<T_Key> batch;
+		for (int i = 0; i < 2000; ++i)
+			batch.push_back(Key<T_Key>(static_cast<int>(random() % 3000)));
+		set.Insert(batch.begin(), batch.end());
+		setReference.insert(batch.begin(), batch.end());
+
+		DVTL_CHECK(set.Size() == setReference.size() && std::equal(setReference.begin(), setReference.end(), set.Begin()));
+		for (int i = 0; i < 300; ++i) {
+			T_Key key = Key<T_Key>(static_cast<int>(random() % 3100));
+			DVTL_CHECK(set.Contains(key) == (setReference.count(key) != 0));
+			DVTL_CHECK(set.Lower_bound(key) - set.Begin() == std::distance(setReference.begin(), setReference.lower_bound(key)));
+		}
+	}
+
+	//iteration order is unspecified, so every element is looked up instead
+	template<typename T_Map, typename T_Key>
+	bool Same_unordered(const T_Map& map, const std::map<T_Key, int>& reference)
+	{
+		if (map.Size() != reference.size() || map.Empty() != reference.empty()) return false;
+
+		size_t visited = 0;
+		for (auto it = map.Begin(); it != map.End(); ++it) {
+			auto expected = reference.find(it->First);
+			if (expected == reference.end() || expected->second != it->Second.value) return false;
+			++visited;
+		}
+		return visited == reference.size();
+	}
+
+	template<typename T_Key>
+	void Check_hash_map(int seed)
+	{
+		typedef DVTL::Hash_map<T_Key, Counted> Map;
+		std::mt19937 random(seed);
+		{
+			Map map;
+			std::map<T_Key, int> reference;
+			DVTL_CHECK(map.Begin() == map.End());
+
+			//key ranges from dense to sparse change how far probes run and how erases shift
+			const int ranges[] = { 64, 2000, 50000 };
+			for (int range : ranges) {
+				for (int phase = 0; phase < 4; ++phase) {
+					Random_operations(map, reference, random, 5000, range);
+					DVTL_CHECK(Same_unordered(map, reference));
+				}
+			}
+
+			Map copy(map);
+			DVTL_CHECK(Same_unordered(copy, reference));
+			Map moved(DVTL::Move(copy));
+			DVTL_CHECK(Same_unordered(moved, reference) && copy.Empty());
+
+			//churn: a window of keys slides over the key space, every step erases one key and inserts another
+			map.Clear();
+			reference.clear();
+			for (int i = 0; i < 20000; ++i) {
+				T_Key added = Key<T_Key>(i);
+				DVTL_CHECK(map.Insert(added, Counted(i)).Second);
+				reference.emplace(added, i);
+				if (i >= 700) {
+					T_Key removed = Key<T_Key>(i - 700);
+					DVTL_CHECK(map.Erase(removed));
+					reference.erase(removed);
+				}
+			}
+			DVTL_CHECK(Same_unordered(map, reference));
+			DVTL_CHECK(!map.Erase(Key<T_Key>(5)));
+
+			map.Reserve(100000);
+			DVTL_CHECK(Same_unordered(map, reference));
+		}
+		DVTL_CHECK(liveValues == 0);
+	}
+}
+
+int main()
+{
+	Check_ordered_map<DVTL::Map<int, Counted>, int>("Map", 1, 2000);
+	Check_ordered_map<DVTL::Map<std::string, Counted>, std::string>("Map", 2, 500);
+	Check_map_queries<int>(3);
+	Check_map_queries<std::string>(4);
+	Check_map_bulk<int>(5);
+	Check_map_bulk<std::string>(6);
+
+	Check_ordered_map<DVTL::Compact_map<int, Counted>, int>("Compact_map", 7, 2000);
+	Check_ordered_map<DVTL::Compact_map<std::string, Counted, true>, std::string>("Compact_map", 8, 500);
+	Check_compact_map<false>(9);
+	Check_compact_map<true>(10);
+	Check_compact_map_statistics(11);
+
+	//small nodes make the trees deep, so splits and merges of inner nodes run often
+	Check_ordered_map<DVTL::BTree_map<int, Counted>, int>("BTree_map", 12, 2000);
+	Check_ordered_map<DVTL::BTree_map<int, Counted, 64>, int>("BTree_map", 13, 5000);
+	Check_ordered_map<DVTL::BTree_map<std::string, Counted, 128>, std::string>("BTree_map", 14, 3000);
+
+	Check_flat_containers<int>(15);
+	Check_flat_containers<std::string>(16);
+
+	Check_hash_map<int>(17);
+	Check_hash_map<std::string>(18);
+
+	return Check::Finish("dvtl_test_containers");
+}
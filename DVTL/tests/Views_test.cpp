@@ -0,0 +1,151 @@
+//view pipelines compared with hand written loops, over filled and empty containers
+
+#include <map>
+#include <vector>
+
+#include "Map.h"
+#include "Vector.h"
+#include "Views.h"
+#include "Check.h"
+
+using namespace DVTL;
+
+namespace
+{
+	template<typename T>
+	bool Same(const Vector<T>& vector, const std::vector<T>& reference)
+	{
+		if (vector.Size() != reference.size()) return false;
+		for (size_t i = 0; i < reference.size(); ++i)
+			if (!(vector[i] == reference[i])) return false;
+		return true;
+	}
+
+	void Check_empty_map()
+	{
+		Map<int, int> map;
+		const Map<int, int>& constMap = map;
+
+		DVTL_CHECK(map.Begin() == map.End());
+		DVTL_CHECK(map.RBegin() == map.REnd());
+		DVTL_CHECK(constMap.CBegin() == constMap.CEnd());
+		DVTL_CHECK(constMap.CRBegin() == constMap.CREnd());
+
+		size_t visited = 0;
+		for (auto it = map.Begin(); it != map.End(); ++it)
+			++visited;
+		for (auto it = constMap.RBegin(); it != constMap.REnd(); ++it)
+			++visited;
+		DVTL_CHECK(visited == 0);
+
+		auto positive = map | Views::Filter([](const Pair<const int, int>& entry) { return entry.Second > 0; }) | Views::To<Vector>();
+		DVTL_CHECK(positive.Empty());
+
+		auto keys = map | Views::Transform([](const Pair<const int, int>& entry) { return entry.First; }) | Views::Take(3) | Views::To<Vector>();
+		DVTL_CHECK(keys.Empty());
+		DVTL_CHECK((map | Views::Enumerate() | Views::Drop(1) | Views::To<Vector>()).Empty());
+
+		//a map emptied by erasing is iterated the same way
+		map.Insert(1, 1);
+		map.Erase(1);
+		DVTL_CHECK(map.Begin() == map.End() && map.RBegin() == map.REnd());
+		DVTL_CHECK((map | Views::Filter([](const Pair<const int, int>&) { return true; }) | Views::To<Vector>()).Empty());
+	}
+
+	void Check_map_pipelines()
+	{
+		Map<int, int> map;
+		std::map<int, int> reference;
+		for (int i = 0; i < 200; ++i) {
+			map.Insert((i * 37) % 211, i);
+			reference.emplace((i * 37) % 211, i);
+		}
+
+		std::vector<int> expected;
+		for (const auto& entry : reference)
+			if (entry.second % 3 == 0) expected.push_back(entry.first * 2);
+
+		auto doubled = map
+			| Views::Filter([](const Pair<const int, int>& entry) { return entry.Second % 3 == 0; })
+			| Views::Transform([](const Pair<const int, int>& entry) { return entry.First * 2; })
+			| Views::To<Vector>();
+		DVTL_CHECK(Same(doubled, expected));
+
+		std::vector<int> strided;
+		size_t index = 0;
+		for (const auto& entry : reference) {
+			if (index >= 10 && index < 110 && (index - 10) % 4 == 0) strided.push_back(entry.second);
+			++index;
+		}
+
+		auto values = map
+			| Views::Drop(10)
+			| Views::Take(100)
+			| Views::Stride(4)
+			| Views::Transform([](const Pair<const int, int>& entry) { return entry.Second; })
+			| Views::To<Vector>();
+		DVTL_CHECK(Same(values, strided));
+	}
+
+	void Check_vector_pipelines()
+	{
+		Vector<int> vector;
+		std::vector<int> reference;
+		for (int i = 0; i < 103; ++i) {
+			vector.Push_back(i * 7 % 50);
+			reference.push_back(i * 7 % 50);
+		}
+
+		std::vector<int> sums;
+		for (size_t first = 0; first < reference.size(); first += 10) {
+			int sum = 0;
+			for (size_t i = first; i < first + 10 && i < reference.size(); ++i)
+				sum += reference[i];
+			sums.push_back(sum);
+		}
+
+		auto chunkSums = vector
+			| Views::Chunk(10)
+			| Views::Transform([](const auto& chunk) { int sum = 0; for (auto it = chunk.Begin(); it != chunk.End(); ++it) sum += *it; return sum; })
+			| Views::To<Vector>();
+		DVTL_CHECK(Same(chunkSums, sums));
+
+		std::vector<size_t> indices;
+		for (size_t i = 0; i < reference.size(); ++i)
+			if (reference[i] > 40) indices.push_back(i);
+
+		auto found = vector
+			| Views::Enumerate()
+			| Views::Filter([](const auto& entry) { return entry.Second > 40; })
+			| Views::Transform([](const auto& entry) { return entry.First; })
+			| Views::To<Vector>();
+		DVTL_CHECK(Same(found, indices));
+
+		Vector<int> other;
+		for (int i = 0; i < 60; ++i)
+			other.Push_back(i);
+
+		std::vector<int> products;
+		for (size_t i = 0; i < 60; ++i)
+			products.push_back(reference[i] * static_cast<int>(i));
+
+		auto zipped = Views::Zip(vector, other)
+			| Views::Transform([](const auto& entry) { return entry.First * entry.Second; })
+			| Views::To<Vector>();
+		DVTL_CHECK(Same(zipped, products));
+
+		Vector<int> empty;
+		DVTL_CHECK((empty | Views::Chunk(4) | Views::To<Vector>()).Empty());
+		DVTL_CHECK((Views::Zip(empty, other) | Views::To<Vector>()).Empty());
+		DVTL_CHECK((vector | Views::Drop(500) | Views::To<Vector>()).Empty());
+	}
+}
+
+int main()
+{
+	Check_empty_map();
+	Check_map_pipelines();
+	Check_vector_pipelines();
+
+	return Check::Finish("dvtl_test_views");
+}